@@ -225,7 +225,7 @@ void heal_t::assess_damage(result_amount_type heal_type, action_state_t* s)
     proc_types pt = s->proc_type();
     proc_types2 pt2 = s->impact_proc_type2();
     if (pt != PROC1_INVALID && pt2 != PROC2_INVALID)
-      action_callback_t::trigger(player->callbacks.procs[pt][pt2], this, s);
+      proc_dispatch.trigger(this, pt, pt2, s);
   }
 
   if (player->record_healing())
@@ -0,0 +1,110 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#include "proc_dispatch.hpp"
+
+#include "action/action_callback.hpp"
+#include "action/dbc_proc_callback.hpp"
+#include "action/sc_action.hpp"
+#include "player/sc_player.hpp"
+#include "sim/real_ppm.hpp"
+#include "sim/sc_cooldown.hpp"
+#include "sim/sc_sim.hpp"
+
+#include <typeinfo>
+
+namespace
+{
+// Only callbacks of exactly dbc_proc_callback_t are known to run its trigger() checks, and nothing
+// else, before rolling the proc. Subclasses may override trigger() with checks ( or rolls ) of their
+// own.
+const dbc_proc_callback_t* plain_dbc_callback( const action_callback_t* cb )
+{
+  if ( typeid( *cb ) != typeid( dbc_proc_callback_t ) )
+  {
+    return nullptr;
+  }
+
+  return static_cast<const dbc_proc_callback_t*>( cb );
+}
+}  // namespace
+
+void proc_dispatch_t::table_t::build( const action_t& action )
+{
+  const auto& callbacks_ = action.player->callbacks;
+
+  version = callbacks_.version;
+  proc = action.proc;
+  callbacks.clear();
+  cooldowns.clear();
+  rppms.clear();
+
+  for ( action_callback_t* cb : callbacks_.procs[ type ][ type2 ] )
+  {
+    const auto dbc_cb = plain_dbc_callback( cb );
+
+    // Callbacks never trigger their own proc action. Callbacks that stop the dispatch for proc
+    // actions stay in, regardless.
+    if ( dbc_cb && dbc_cb->proc_action && dbc_cb->proc_action->internal_id == action.internal_id &&
+         ( cb->allow_procs || !action.proc ) )
+    {
+      continue;
+    }
+
+    callbacks.push_back( cb );
+
+    // Failed checks are logged in debug mode, so they have to run
+    bool precheck = dbc_cb && !action.sim->debug;
+    cooldowns.push_back( precheck ? dbc_cb->cooldown : nullptr );
+    rppms.push_back( precheck ? dbc_cb->rppm : nullptr );
+  }
+}
+
+proc_dispatch_t::table_t& proc_dispatch_t::table( const action_t& action, proc_types pt, proc_types2 pt2 )
+{
+  for ( auto& t : tables )
+  {
+    if ( t->type == pt && t->type2 == pt2 )
+    {
+      if ( t->version != action.player->callbacks.version || t->proc != action.proc )
+      {
+        t->build( action );
+      }
+      return *t;
+    }
+  }
+
+  tables.push_back( std::make_unique<table_t>() );
+  auto& t = *tables.back();
+  t.type = pt;
+  t.type2 = pt2;
+  t.build( action );
+  return t;
+}
+
+void proc_dispatch_t::trigger( action_t* action, proc_types pt, proc_types2 pt2, action_state_t* state )
+{
+  if ( !action->player->in_combat )
+    return;
+
+  const auto& t = table( *action, pt, pt2 );
+  for ( size_t i = 0; i < t.callbacks.size(); ++i )
+  {
+    action_callback_t* cb = t.callbacks[ i ];
+    if ( !cb->active )
+      continue;
+
+    if ( !cb->allow_procs && action->proc )
+      return;
+
+    if ( t.cooldowns[ i ] && t.cooldowns[ i ]->down() )
+      continue;
+
+    if ( t.rppms[ i ] && !t.rppms[ i ]->can_trigger() )
+      continue;
+
+    cb->trigger( action, state );
+  }
+}
@@ -0,0 +1,53 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#pragma once
+
+#include "config.hpp"
+#include "dbc/data_enums.hh"
+
+#include <memory>
+#include <vector>
+
+struct action_t;
+struct action_callback_t;
+struct action_state_t;
+struct cooldown_t;
+struct real_ppm_t;
+
+/* Per-action proc callback dispatch
+ *
+ * For each proc type and result type an action triggers, the player callbacks of that type
+ * (effect_callbacks_t::procs) are flattened into a table, built on first use and rebuilt whenever
+ * callbacks are registered. Callbacks the action can never trigger are left out of the table.
+ * Plain dbc_proc_callback_t callbacks keep their cooldown and RPPM in parallel arrays, so a
+ * callback on cooldown, or with an RPPM that cannot roll at the current time, is skipped without
+ * calling it.
+ */
+class proc_dispatch_t
+{
+  struct table_t
+  {
+    proc_types type;
+    proc_types2 type2;
+    unsigned version;
+    bool proc;
+
+    std::vector<action_callback_t*> callbacks;
+    std::vector<const cooldown_t*> cooldowns;  // nullptr if not checked before the trigger
+    std::vector<const real_ppm_t*> rppms;      // nullptr if not checked before the trigger
+
+    void build( const action_t& action );
+  };
+
+  // Tables keep their address, a callback may trigger procs of the same action
+  std::vector<std::unique_ptr<table_t>> tables;
+
+  table_t& table( const action_t& action, proc_types pt, proc_types2 pt2 );
+
+public:
+  // Equivalent to action_callback_t::trigger() of the player callbacks of the given types
+  void trigger( action_t* action, proc_types pt, proc_types2 pt2, action_state_t* state );
+};
@@ -388,6 +388,7 @@ action_t::action_t( action_e ty, util::string_view token, player_t* p, const spe
     option(),
     interrupt_global( false ),
     if_expr(),
+    if_expr_memo(),
     target_if_mode( TARGET_IF_NONE ),
     target_if_expr(),
     interrupt_if_expr(),
@@ -408,7 +409,8 @@ action_t::action_t( action_e ty, util::string_view token, player_t* p, const spe
     target_cache(),
     options(),
     state_cache(),
-    travel_events()
+    travel_events(),
+    proc_dispatch()
 {
   assert( option.cycle_targets == 0 );
   assert( !name_str.empty() && "Abilities must have valid name_str entries!!" );
@@ -1663,20 +1665,20 @@ void action_t::execute()
       // "On spell cast", only performed for foreground actions
       if ( ( pt2 = execute_state->cast_proc_type2() ) != PROC2_INVALID )
       {
-        action_callback_t::trigger( player->callbacks.procs[ pt ][ pt2 ], this, execute_state );
+        proc_dispatch.trigger( this, pt, pt2, execute_state );
       }
 
       // "On an execute result"
       if ( ( pt2 = execute_state->execute_proc_type2() ) != PROC2_INVALID )
       {
-        action_callback_t::trigger( player->callbacks.procs[ pt ][ pt2 ], this, execute_state );
+        proc_dispatch.trigger( this, pt, pt2, execute_state );
       }
 
       // "On interrupt cast result"
       if ( ( pt2 = execute_state->interrupt_proc_type2() ) != PROC2_INVALID )
       {
         if ( execute_state->target->debuffs.casting->check() )
-          action_callback_t::trigger( player->callbacks.procs[ pt ][ pt2 ], this, execute_state );
+          proc_dispatch.trigger( this, pt, pt2, execute_state );
       }
     }
   }
@@ -2256,12 +2258,50 @@ bool action_t::action_ready()
   if ( option.moving != -1 && option.moving != ( player->is_moving() ? 1 : 0 ) )
     return false;
 
-  if ( if_expr && !if_expr->success() )
+  if ( if_expr && !if_expr_ready() )
     return false;
 
   return true;
 }
 
+bool action_t::if_expr_ready()
+{
+  if ( !sim->memoize_conditions )
+  {
+    return if_expr->success();
+  }
+
+  double value;
+  bool reused = if_expr_memo && if_expr_memo->lookup( sim->current_time(), target, value );
+  if ( reused && sim->validate_memoized_conditions )
+  {
+    double evaluated = if_expr->eval();
+    if ( ( evaluated != 0 ) != ( value != 0 ) )
+    {
+      sim->error( "{} memoized if expression of action '{}' is {}, evaluated {}.", *player, signature_str, value,
+                  evaluated );
+      // Report each action only once, and evaluate it in full from here on
+      if_expr_memo.reset();
+    }
+    value = evaluated;
+  }
+  else if ( !reused )
+  {
+    value = if_expr->eval();
+    if ( if_expr_memo )
+    {
+      if_expr_memo->store( sim->current_time(), target, value );
+    }
+  }
+
+  if ( action_list )
+  {
+    ( reused ? action_list->condition_reuses : action_list->condition_evaluations )++;
+  }
+
+  return value != 0;
+}
+
 // Properties that govern if the spell itself is executable, without considering any kind of user
 // options
 bool action_t::ready()
@@ -2653,6 +2693,15 @@ void action_t::reset()
       expr_t::optimize_expression(interrupt_if_expr);
       expr_t::optimize_expression(early_chain_if_expr);
       expr_t::optimize_expression(cancel_if_expr);
+
+      if ( sim->memoize_conditions && if_expr )
+      {
+        auto memo = std::make_unique<expression::memo_t>( *if_expr );
+        if ( memo->reusable() )
+        {
+          if_expr_memo = std::move( memo );
+        }
+      }
   }
 }
 
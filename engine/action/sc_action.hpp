@@ -7,6 +7,7 @@
 
 #include "config.hpp"
 #include "dbc/data_definitions.hh"
+#include "action/proc_dispatch.hpp"
 #include "player/target_specific.hpp"
 #include "player/covenant.hpp"
 #include "sc_enums.hpp"
@@ -37,6 +38,9 @@ struct proc_t;
 namespace rng {
   struct rng_t;
 }
+namespace expression {
+  class memo_t;
+}
 struct spelleffect_data_t;
 struct stats_t;
 struct travel_event_t;
@@ -459,6 +463,8 @@ public:
   bool interrupt_global;
 
   std::unique_ptr<expr_t> if_expr;
+  /// Reuses if expression results while the state they read is unchanged, see sim_t::memoize_conditions
+  std::unique_ptr<expression::memo_t> if_expr_memo;
 
   enum target_if_mode_e
   {
@@ -526,6 +532,9 @@ private:
   action_state_t* state_cache;
   std::vector<travel_event_t*> travel_events;
 public:
+  /// Player proc callbacks triggered by the action, by proc type and result type
+  proc_dispatch_t proc_dispatch;
+
   action_t( action_e type, util::string_view token, player_t* p );
   action_t( action_e type, util::string_view token, player_t* p, const spell_data_t* s );
 
@@ -907,6 +916,8 @@ public:
   /// Is the action ready, as a combination of ability characteristics and user input? Main
   /// ntry-point when selecting something to do for an actor.
   virtual bool action_ready();
+  /// Evaluate the if expression, or reuse its memoized result
+  bool if_expr_ready();
   /// Select a target to execute on
   virtual bool select_target();
   /// Target readiness state checking
@@ -57,6 +57,7 @@ stats_t::stats_t( util::string_view n, player_t* p ) :
   if ( sim.report_details != 0 )
   {
     timeline_amount = std::make_unique<sc_timeline_t>( );
+    timeline_amount -> reserve( timespan_t::from_seconds( sim.expected_max_time() ) );
   }
 }
 
@@ -287,6 +287,8 @@ void variable_t::execute()
       operation, var->current_value_, var->default_value_, signature_str);
   }
 
+  double previous_value = var->current_value_;
+
   switch (operation)
   {
   case OPERATION_SET:
@@ -366,6 +368,11 @@ void variable_t::execute()
     assert(0);
     break;
   }
+
+  if ( var->current_value_ != previous_value )
+  {
+    var->version_++;
+  }
 }
 
 void cycling_variable_t::execute()
@@ -0,0 +1,70 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#include "buff_registry.hpp"
+
+#include "buff/sc_buff.hpp"
+
+unsigned buff_registry_t::intern( util::string_view name, util::string_view& interned_name )
+{
+  AUTO_LOCK( mutex );
+
+  auto it = ids.find( name );
+  if ( it == ids.end() )
+  {
+    names.emplace_back( name );
+    it = ids.emplace( names.back(), as<unsigned>( ids.size() ) ).first;
+  }
+
+  interned_name = it->first;
+  return it->second;
+}
+
+unsigned buff_names_t::intern( buff_registry_t& registry, util::string_view name )
+{
+  auto it = ids.find( name );
+  if ( it != ids.end() )
+  {
+    return it->second;
+  }
+
+  util::string_view interned_name;
+  unsigned id = registry.intern( name, interned_name );
+  ids.emplace( interned_name, id );
+  return id;
+}
+
+void buff_index_t::add( buff_t& buff )
+{
+  if ( first.size() <= buff.name_id )
+  {
+    first.resize( buff.name_id + 1, nullptr );
+  }
+
+  buff_t** slot = &first[ buff.name_id ];
+  while ( *slot )
+  {
+    slot = &( *slot )->next_by_name;
+  }
+  *slot = &buff;
+}
+
+buff_t* buff_index_t::find( unsigned name_id, const player_t* source ) const
+{
+  if ( name_id >= first.size() )
+  {
+    return nullptr;
+  }
+
+  for ( buff_t* buff = first[ name_id ]; buff; buff = buff->next_by_name )
+  {
+    if ( !source || source == buff->source )
+    {
+      return buff;
+    }
+  }
+
+  return nullptr;
+}
@@ -0,0 +1,74 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#pragma once
+
+#include "config.hpp"
+#include "util/concurrency.hpp"
+#include "util/string_view.hpp"
+
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct buff_t;
+struct player_t;
+
+/* Sim-wide buff name ids
+ *
+ * Buff names are interned to dense ids when the first buff of a name is created. The registry is
+ * shared by a sim and all of its child sims, so a name has the same id in every thread, and buffs
+ * of different threads are paired by id instead of by comparing names.
+ */
+class buff_registry_t
+{
+  mutex_t mutex;
+  // Interned names, never removed, so views of them stay valid for the lifetime of the registry
+  std::deque<std::string> names;
+  std::unordered_map<util::string_view, unsigned> ids;
+
+public:
+  static constexpr unsigned npos = ~0U;
+
+  // Id of the name, creating one if the name has not been interned yet. Returns the interned copy
+  // of the name in interned_name.
+  unsigned intern( util::string_view name, util::string_view& interned_name );
+};
+
+/* Buff name ids of the buffs created in one sim
+ *
+ * Looking up a name does not lock, as the map is only used by the thread of its sim. Only the first
+ * buff of a name created in the sim interns the name in the shared registry. Names of buffs the sim
+ * did not create have no id here, there is no buff of the sim to find for them anyway.
+ */
+class buff_names_t
+{
+  std::unordered_map<util::string_view, unsigned> ids;
+
+public:
+  // Id of the name in the registry, interning it if no buff of the name was created in the sim yet
+  unsigned intern( buff_registry_t& registry, util::string_view name );
+
+  // Id of the name, or buff_registry_t::npos if no buff of that name was created in the sim
+  unsigned find( util::string_view name ) const
+  {
+    auto it = ids.find( name );
+    return it != ids.end() ? it->second : buff_registry_t::npos;
+  }
+};
+
+// Buffs of a player ( or the sim ) by name id. Buffs of the same name ( e.g., debuffs of different
+// sources ) are chained in creation order.
+class buff_index_t
+{
+  std::vector<buff_t*> first;
+
+public:
+  void add( buff_t& buff );
+
+  // First buff with the name id from source, or from any source if source is nullptr
+  buff_t* find( unsigned name_id, const player_t* source = nullptr ) const;
+};
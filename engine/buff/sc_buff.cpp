@@ -310,6 +310,15 @@ std::unique_ptr<expr_t> create_buff_expression( util::string_view buff_name, uti
             n, buff_name, action, static_buff, std::forward<Fn>( fn ), default_ );
   };
 
+  // Expressions of a fixed buff that only read its stack count
+  auto stack_buff_expr = [ static_buff ]( std::unique_ptr<expr_t> expr ) {
+    if ( static_buff )
+    {
+      expr->depends_on( &static_buff->stack_version );
+    }
+    return expr;
+  };
+
   if ( type == "duration" )
   {
     return make_buff_expr( "buff_duration",
@@ -333,24 +342,24 @@ std::unique_ptr<expr_t> create_buff_expression( util::string_view buff_name, uti
   }
   else if ( type == "up" )
   {
-    return make_buff_expr( "buff_up",
+    return stack_buff_expr( make_buff_expr( "buff_up",
       []( buff_t* buff ) {
         return buff->check() > 0;
-      } );
+      } ) );
   }
   else if ( type == "down" )
   {
-    return make_buff_expr( "buff_down",
+    return stack_buff_expr( make_buff_expr( "buff_down",
       []( buff_t* buff ) {
         return buff->check() <= 0;
-      }, 1.0 );
+      }, 1.0 ) );
   }
   else if ( type == "stack" )
   {
-    return make_buff_expr( "buff_stack",
+    return stack_buff_expr( make_buff_expr( "buff_stack",
       []( buff_t* buff ) {
         return buff->check();
-      } );
+      } ) );
   }
   else if ( type == "stack_pct" )
   {
@@ -483,6 +492,7 @@ buff_t::buff_t( sim_t* sim, player_t* target, player_t* source, util::string_vie
     player( target ),
     item( item ),
     name_str( name ),
+    name_id( sim->buff_names.intern( *sim->buff_registry, name_str ) ),
     s_data( spell_data ),
     s_data_reporting( spell_data_t::nil() ),
     source( source ),
@@ -491,6 +501,7 @@ buff_t::buff_t( sim_t* sim, player_t* target, player_t* source, util::string_vie
     expiration_delay(),
     cooldown(),
     rppm( nullptr ),
+    next_by_name( nullptr ),
     _max_stack( -1 ),
     _initial_stack( -1 ),
     trigger_data( s_data ),
@@ -508,6 +519,7 @@ buff_t::buff_t( sim_t* sim, player_t* target, player_t* source, util::string_vie
     reverse_stack_reduction( 1 ),
     current_value(),
     current_stack(),
+    stack_version( 0 ),
     base_buff_duration( timespan_t::min() ),
     buff_duration_multiplier( 1.0 ),
     default_chance( 1.0 ),
@@ -553,11 +565,13 @@ buff_t::buff_t( sim_t* sim, player_t* target, player_t* source, util::string_vie
   if ( source )  // Player Buffs
   {
     player->buff_list.push_back( this );
+    player->buff_index.add( *this );
     cooldown = source->get_cooldown( "buff_" + name_str );
   }
   else  // Sim Buffs
   {
     sim->buff_list.push_back( this );
+    sim->buff_index.add( *this );
     cooldown = sim->get_cooldown( "buff_" + name_str );
   }
 
@@ -1782,6 +1796,7 @@ void buff_t::decrement( int stacks, double value )
       stack_uptime[ current_stack ].update( false, sim->current_time() );
 
     current_stack -= stacks;
+    stack_version++;
 
     if ( value != DEFAULT_VALUE() )
       current_value = value;
@@ -2070,6 +2085,7 @@ void buff_t::bump( int stacks, double value )
   if ( max_stack() < 0 )
   {
     current_stack += stacks;
+    stack_version++;
     changes_stack_value = true;
   }
   // Asynchronous buffs need to adjust their expiration even when bumped at max stacks.
@@ -2079,6 +2095,7 @@ void buff_t::bump( int stacks, double value )
     int before_stack = current_stack;
 
     current_stack += stacks;
+    stack_version++;
     if ( current_stack > max_stack() )
     {
       int overflow = current_stack - max_stack();
@@ -2086,6 +2103,7 @@ void buff_t::bump( int stacks, double value )
       overflow_count++;
       overflow_total += overflow;
       current_stack = max_stack();
+      stack_version++;
 
       if ( stack_behavior == buff_stack_behavior::ASYNCHRONOUS )
       {
@@ -2272,6 +2290,7 @@ void buff_t::expire( timespan_t delay )
   int old_stack = current_stack;
 
   current_stack = 0;
+  stack_version++;
 
   if ( last_start >= timespan_t::zero() )
   {
@@ -2498,6 +2517,14 @@ buff_t* buff_t::find_expressable( util::span<buff_t* const> buffs, util::string_
     return find( buffs, name, source );
 }
 
+buff_t* buff_t::find_expressable( player_t* p, util::string_view name, player_t* source )
+{
+  if ( util::str_compare_ci( "potion", name ) )
+    return find_potion_buff( p->buff_list, source );
+  else
+    return find( p, name, source );
+}
+
 std::string buff_t::to_str() const
 {
   std::ostringstream s;
@@ -2548,12 +2575,28 @@ void buff_t::invalidate_cache()
 
 buff_t* buff_t::find( sim_t* s, util::string_view name )
 {
-  return find( s->buff_list, name );
+  s->count_buff_lookup();
+
+  unsigned name_id = s->buff_names.find( name );
+  if ( name_id == buff_registry_t::npos )
+  {
+    return nullptr;
+  }
+
+  return s->buff_index.find( name_id );
 }
 
 buff_t* buff_t::find( player_t* p, util::string_view name, player_t* source )
 {
-  return find( p->buff_list, name, source );
+  p->sim->count_buff_lookup();
+
+  unsigned name_id = p->sim->buff_names.find( name );
+  if ( name_id == buff_registry_t::npos )
+  {
+    return nullptr;
+  }
+
+  return p->buff_index.find( name_id, source );
 }
 
 util::string_view buff_t::source_name() const
@@ -2808,6 +2851,7 @@ void stat_buff_t::decrement( int stacks, double /* value */ )
       buff_stat.current_value -= delta;
     }
     current_stack -= stacks;
+    stack_version++;
 
     invalidate_cache();
 
@@ -2913,6 +2957,7 @@ void cost_reduction_buff_t::decrement( int stacks, double /* value */ )
     double delta = amount * stacks;
     player->cost_reduction_loss( school, delta );
     current_stack -= stacks;
+    stack_version++;
     current_value -= delta;
   }
 }
@@ -58,6 +58,8 @@ public:
   player_t* const player;
   const item_t* const item;
   const std::string name_str;
+  // Sim-wide id of name_str, see buff_registry_t
+  const unsigned name_id;
   const spell_data_t* s_data;
   const spell_data_t* s_data_reporting;
   player_t* const source;
@@ -67,6 +69,8 @@ public:
   cooldown_t* cooldown;
   sc_timeline_t uptime_array;
   real_ppm_t* rppm;
+  // Next buff of the same name in the buff index of the player ( or sim )
+  buff_t* next_by_name;
 
   // static values
 private: // private because changing max_stacks requires resizing some stack-dependant vectors
@@ -93,6 +97,7 @@ public:
   // dynamic values
   double current_value;
   int current_stack;
+  uint64_t stack_version; /// Bumped on every change to current_stack
   timespan_t base_buff_duration;
   double buff_duration_multiplier;
   double default_chance;
@@ -297,6 +302,7 @@ public:
   static buff_t* find( sim_t*, util::string_view name );
   static buff_t* find( player_t*, util::string_view name, player_t* source = nullptr );
   static buff_t* find_expressable( util::span<buff_t* const>, util::string_view name, player_t* source = nullptr );
+  static buff_t* find_expressable( player_t*, util::string_view name, player_t* source = nullptr );
 
   const char* name() const { return name_str.c_str(); }
   util::string_view source_name() const;
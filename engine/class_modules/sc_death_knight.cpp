@@ -7014,6 +7014,7 @@ struct vampiric_blood_buff_t : public buff_t
     player -> resources.initial_multiplier[ RESOURCE_HEALTH ] *= 1.0 + health_change;
     player -> recalculate_resource_max( RESOURCE_HEALTH );
     player -> resources.current[ RESOURCE_HEALTH ] *= 1.0 + health_change; // Update health after the maximum is increased
+    player -> resource_version++;
 
     sim -> print_debug( "{} gains Vampiric Blood: health pct change {}%, current health: {} -> {}, max: {} -> {}",
                                   player -> name(), health_change * 100.0,
@@ -7028,6 +7029,7 @@ struct vampiric_blood_buff_t : public buff_t
 
     player -> resources.initial_multiplier[ RESOURCE_HEALTH ] /= 1.0 + health_change;
     player -> resources.current[ RESOURCE_HEALTH ] /= 1.0 + health_change; // Update health before the maximum is reduced
+    player -> resource_version++;
     player -> recalculate_resource_max( RESOURCE_HEALTH );
 
     sim -> print_debug( "{} loses Vampiric Blood: health pct change {}%, current health: {} -> {}, max: {} -> {}",
@@ -1513,6 +1513,7 @@ struct ursine_vigor_buff_t : public druid_buff_t<buff_t>
 
     p().resources.max[ RESOURCE_HEALTH ] *= hp_mul;
     p().resources.current[ RESOURCE_HEALTH ] *= hp_mul;
+    p().resource_version++;
     p().recalculate_resource_max( RESOURCE_HEALTH );
   }
 
@@ -1520,6 +1521,7 @@ struct ursine_vigor_buff_t : public druid_buff_t<buff_t>
   {
     p().resources.max[ RESOURCE_HEALTH ] /= hp_mul;
     p().resources.current[ RESOURCE_HEALTH ] /= hp_mul;
+    p().resource_version++;
     p().recalculate_resource_max( RESOURCE_HEALTH );
 
     base_t::expire_override( s, d );
@@ -1762,6 +1764,7 @@ struct berserk_bear_buff_t : public druid_buff_t<buff_t>
     {
       p().resources.max[ RESOURCE_HEALTH ] *= hp_mul;
       p().resources.current[ RESOURCE_HEALTH ] *= hp_mul;
+      p().resource_version++;
       p().recalculate_resource_max( RESOURCE_HEALTH );
     }
   }
@@ -1772,6 +1775,7 @@ struct berserk_bear_buff_t : public druid_buff_t<buff_t>
     {
       p().resources.max[ RESOURCE_HEALTH ] /= hp_mul;
       p().resources.current[ RESOURCE_HEALTH ] /= hp_mul;
+      p().resource_version++;
       p().recalculate_resource_max( RESOURCE_HEALTH );
     }
 
@@ -9712,6 +9716,7 @@ void druid_t::combat_begin()
     double curr = resources.current[ RESOURCE_ASTRAL_POWER ];
 
     resources.current [ RESOURCE_ASTRAL_POWER] = std::min( cap, curr );
+    resource_version++;
     
     if ( curr > cap )
       sim->print_debug( "Astral Power capped at combat start to {} (was {})", cap, curr );
@@ -9744,6 +9749,7 @@ void druid_t::recalculate_resource_max( resource_e rt, gain_t* source )
     resources.max[ rt ] *= 1.0 + cache.mastery_value();
     // Maintain current health pct.
     resources.current[ rt ] = resources.max[ rt ] * pct_health;
+    resource_version++;
 
     if ( sim->log )
       sim->out_log.printf( "%s recalculates maximum health. old_current=%.0f new_current=%.0f net_health=%.0f", name(),
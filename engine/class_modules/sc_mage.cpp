@@ -6885,6 +6885,7 @@ void mage_t::recalculate_resource_max( resource_e rt, gain_t* source )
     resources.max[ rt ] *= 1.0 + buffs.arcane_familiar->check_value();
 
     resources.current[ rt ] = resources.max[ rt ] * pct;
+    resource_version++;
     sim->print_debug( "{} adjusts maximum mana from {} to {} ({}%)", name(), max, resources.max[ rt ], 100.0 * pct );
   }
 }
@@ -8903,6 +8903,7 @@ void rogue_t::arise()
   player_t::arise();
 
   resources.current[ RESOURCE_COMBO_POINT ] = 0;
+  resource_version++;
 }
 
 // rogue_t::combat_begin ====================================================
@@ -6508,6 +6508,7 @@ struct rallying_cry_t : public warrior_buff_t<buff_t>
     player -> resources.initial_multiplier[ RESOURCE_HEALTH ] *= 1.0 + health_change;
     player -> recalculate_resource_max( RESOURCE_HEALTH );
     player -> resources.current[ RESOURCE_HEALTH ] *= 1.0 + health_change; // Update health after the maximum is increased
+    player -> resource_version++;
 
     sim -> print_debug( "{} gains Rallying Cry: health pct change {}%, current health: {} -> {}, max: {} -> {}",
                         player -> name(), health_change * 100.0,
@@ -6522,6 +6523,7 @@ struct rallying_cry_t : public warrior_buff_t<buff_t>
 
     player -> resources.initial_multiplier[ RESOURCE_HEALTH ] /= 1.0 + health_change;
     player -> resources.current[ RESOURCE_HEALTH ] /= 1.0 + health_change; // Update health before the maximum is reduced
+    player -> resource_version++;
     player -> recalculate_resource_max( RESOURCE_HEALTH );
 
     sim -> print_debug( "{} loses Rallying Cry: health pct change {}%, current health: {} -> {}, max: {} -> {}",
@@ -6553,6 +6555,7 @@ struct last_stand_buff_t : public warrior_buff_t<buff_t>
     player -> resources.initial_multiplier[ RESOURCE_HEALTH ] *= 1.0 + health_change;
     player -> recalculate_resource_max( RESOURCE_HEALTH );
     player -> resources.current[ RESOURCE_HEALTH ] *= 1.0 + health_change; // Update health after the maximum is increased
+    player -> resource_version++;
 
     sim -> print_debug( "{} gains Last Stand: health pct change {}%, current health: {} -> {}, max: {} -> {}",
                         player -> name(), health_change * 100.0,
@@ -13,26 +13,52 @@
 
 namespace
 {
+// Name indexes of the active spells. Names are compared case insensitively, so they are indexed in
+// lower case.
+dbc::name_dbc_index_t<active_class_spell_t> class_name_index, class_token_index;
+dbc::name_dbc_index_t<active_pet_spell_t> pet_name_index, pet_token_index;
+
+std::string name_key( util::string_view name, bool tokenized )
+{
+  std::string key = tokenized ? util::tokenize_fn( name ) : std::string( name );
+  util::tolower( key );
+  return key;
+}
+
+template <typename T>
+void init_index( dbc::name_dbc_index_t<T>& names, dbc::name_dbc_index_t<T>& tokens, bool ptr )
+{
+  names.init( T::data( ptr ), ptr, []( const T& e ) { return name_key( e.name, false ); } );
+  tokens.init( T::data( ptr ), ptr, []( const T& e ) { return name_key( e.name, true ); } );
+}
+
 const active_class_spell_t& __find_class( util::string_view name,
                                           bool              ptr,
                                           bool              tokenized,
                                           player_e          class_,
                                           specialization_e  spec )
 {
-  std::string name_str = tokenized ? util::tokenize_fn( name ) : std::string( name );
   unsigned class_id = util::class_id( class_ );
   unsigned spec_id = static_cast<unsigned>( spec );
 
+  auto filter = [ class_id, spec_id ]( const active_class_spell_t& e ) {
+    return ( class_id == 0 || e.class_id == class_id ) && ( spec_id == 0 || e.spec_id == spec_id );
+  };
+
+  const auto& index = tokenized ? class_token_index : class_name_index;
+  if ( index.initialized( ptr ) )
+  {
+    const auto spell = index.find( name_key( name, tokenized ), ptr, filter );
+    return spell ? *spell : active_class_spell_t::nil();
+  }
+
+  std::string name_str = tokenized ? util::tokenize_fn( name ) : std::string( name );
+
   const auto __data = active_class_spell_t::data( ptr );
 
   auto it = range::find_if( __data,
-  [&name_str, tokenized, class_id, spec_id]( const active_class_spell_t& e ) {
-    if ( class_id != 0 && e.class_id != class_id )
-    {
-      return false;
-    }
-
-    if ( spec_id != 0 && e.spec_id != spec_id )
+  [&name_str, tokenized, &filter]( const active_class_spell_t& e ) {
+    if ( ! filter( e ) )
     {
       return false;
     }
@@ -54,14 +80,26 @@ const active_pet_spell_t& __find_pet( util::string_view name,
                                       bool              tokenized,
                                       player_e          class_)
 {
-  std::string name_str = tokenized ? util::tokenize_fn( name ) : std::string( name );
   unsigned class_id = util::class_id( class_ );
 
+  auto filter = [ class_id ]( const active_pet_spell_t& e ) {
+    return class_id == 0 || e.owner_class_id == class_id;
+  };
+
+  const auto& index = tokenized ? pet_token_index : pet_name_index;
+  if ( index.initialized( ptr ) )
+  {
+    const auto spell = index.find( name_key( name, tokenized ), ptr, filter );
+    return spell ? *spell : active_pet_spell_t::nil();
+  }
+
+  std::string name_str = tokenized ? util::tokenize_fn( name ) : std::string( name );
+
   const auto __data = active_pet_spell_t::data( ptr );
 
   auto it = range::find_if( __data,
-  [&name_str, tokenized, class_id]( const active_pet_spell_t& e ) {
-    if ( class_id != 0 && e.owner_class_id != class_id )
+  [&name_str, tokenized, &filter]( const active_pet_spell_t& e ) {
+    if ( ! filter( e ) )
     {
       return false;
     }
@@ -84,6 +122,11 @@ util::span<const active_class_spell_t> active_class_spell_t::data( bool ptr )
   return SC_DBC_GET_DATA( __active_spells_data, __ptr_active_spells_data, ptr );
 }
 
+void active_class_spell_t::init_name_index( bool ptr )
+{
+  init_index( class_name_index, class_token_index, ptr );
+}
+
 const active_class_spell_t&
 active_class_spell_t::find( util::string_view name, bool ptr, bool tokenized )
 {
@@ -113,6 +156,11 @@ util::span<const active_pet_spell_t> active_pet_spell_t::data( bool ptr )
   return SC_DBC_GET_DATA( __active_pet_spells_data, __ptr_active_pet_spells_data, ptr );
 }
 
+void active_pet_spell_t::init_name_index( bool ptr )
+{
+  init_index( pet_name_index, pet_token_index, ptr );
+}
+
 const active_pet_spell_t&
 active_pet_spell_t::find( util::string_view name, bool ptr, bool tokenized )
 {
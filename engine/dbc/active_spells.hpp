@@ -29,6 +29,7 @@ struct active_class_spell_t
   { return dbc::nil<active_class_spell_t>; }
 
   static util::span<const active_class_spell_t> data( bool ptr );
+  static void init_name_index( bool ptr );
 };
 
 struct active_pet_spell_t
@@ -44,6 +45,7 @@ struct active_pet_spell_t
   { return dbc::nil<active_pet_spell_t>; }
 
   static util::span<const active_pet_spell_t> data( bool ptr );
+  static void init_name_index( bool ptr );
 };
 
 #endif /* ACTIVE_SPELLS_HPP */
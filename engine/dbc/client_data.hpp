@@ -13,6 +13,7 @@
 
 #include "util/generic.hpp"
 #include "util/span.hpp"
+#include "util/string_view.hpp"
 
 namespace dbc
 {
@@ -104,6 +105,66 @@ public:
   }
 };
 
+// "Index" to find dbc data by a name key without scanning the whole list. Entries are sorted by
+// key, entries with the same key stay in data order. Key is std::string for keys derived from the
+// name, or util::string_view for keys pointing to the data itself.
+template <typename T, typename Key = std::string>
+class name_dbc_index_t
+{
+  struct entry_t
+  {
+    Key key;
+    const T* data;
+  };
+
+#if SC_USE_PTR == 0
+  std::vector<entry_t> __name_index[ 1 ];
+#else
+  std::vector<entry_t> __name_index[ 2 ];
+#endif
+
+public:
+  // Initialize index from given list, with the key of each entry given by key_fn
+  template <typename KeyFn>
+  void init( util::span<const T> list, bool ptr, KeyFn&& key_fn )
+  {
+    auto& index = __name_index[ SC_USE_PTR && ptr ];
+    index.clear();
+    index.reserve( list.size() );
+    for ( const auto& i : list )
+    {
+      index.push_back( { key_fn( i ), &i } );
+    }
+
+    std::stable_sort( index.begin(), index.end(), []( const entry_t& l, const entry_t& r ) {
+      return util::string_view( l.key ) < util::string_view( r.key );
+    } );
+  }
+
+  bool initialized( bool ptr ) const
+  { return !__name_index[ SC_USE_PTR && ptr ].empty(); }
+
+  // First entry ( in data order ) with the given key that satisfies pred, or nullptr
+  template <typename Predicate>
+  const T* find( util::string_view key, bool ptr, Predicate&& pred ) const
+  {
+    const auto& index = __name_index[ SC_USE_PTR && ptr ];
+    auto it = std::lower_bound( index.begin(), index.end(), key, []( const entry_t& e, util::string_view k ) {
+      return util::string_view( e.key ) < k;
+    } );
+
+    for ( ; it != index.end() && util::string_view( it->key ) == key; ++it )
+    {
+      if ( pred( *it->data ) )
+      {
+        return it->data;
+      }
+    }
+
+    return nullptr;
+  }
+};
+
 // Return World of Warcraft client data version used to generate the current client data
 std::string client_data_version_str( bool ptr );
 // Return World of Warcraft client data build version used to generate the current client data
@@ -0,0 +1,522 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#include "data_bundle.hpp"
+
+#include "gem_data.hpp"
+#include "item_armor.hpp"
+#include "item_bonus.hpp"
+#include "item_child.hpp"
+#include "item_scaling.hpp"
+#include "item_weapon.hpp"
+#include "rand_prop_points.hpp"
+#include "real_ppm_data.hpp"
+#include "spelltext_data.hpp"
+
+#include "fmt/format.h"
+#include "util/io.hpp"
+#include "util/string_view.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#ifdef SC_WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+// Bump the version whenever the layout of the header or directory changes. Changes to the layout of
+// the bundled records are caught by their size.
+const char BUNDLE_MAGIC[ 8 ] = { 's', 'i', 'm', 'c', 'd', 'b', 'c', '\0' };
+const uint32_t BUNDLE_VERSION = 2;
+const uint32_t BUNDLE_BYTE_ORDER = 0x01020304;
+const size_t BUNDLE_ALIGNMENT = 16;
+
+struct header_t
+{
+  char     magic[ 8 ];
+  uint32_t version;
+  uint32_t byte_order;
+  uint32_t n_tables;
+  uint32_t reserved;
+  int32_t  build[ 2 ];     // Client data build of the live and ptr tables
+  uint64_t strings_offset; // String pool shared by all tables with string fields
+  uint64_t strings_size;
+};
+
+// Directory entry of one table, followed by the records at offset from the start of the file
+struct directory_entry_t
+{
+  char     name[ 40 ];
+  uint32_t ptr;
+  uint32_t element_size;
+  uint64_t offset;
+  uint64_t count;
+};
+
+// String fields of bundled records hold the offset of the string in the string pool plus one, or
+// zero for a null string.
+struct table_info_t
+{
+  const char* name;
+  size_t element_size;
+  util::span<const char> ( *data )( bool ptr );
+  std::vector<size_t> strings;  // Offsets of the const char* fields in the record
+};
+
+template <typename T>
+table_info_t info( const char* name, std::initializer_list<size_t> strings = {} )
+{
+  return { name, sizeof( T ), []( bool ptr ) {
+    auto data = T::data( ptr );
+    return util::span<const char>( reinterpret_cast<const char*>( data.data() ), data.size() * sizeof( T ) );
+  }, strings };
+}
+
+// Name and record type of each bundled table, in table_e order
+const std::array<table_info_t, static_cast<size_t>( dbc::bundle::table_e::MAX )> tables { {
+  info<curve_point_t>( "curve_point" ),
+  info<gem_property_data_t>( "gem_property" ),
+  info<item_armor_quality_data_t>( "item_armor_quality" ),
+  info<item_armor_shield_data_t>( "item_armor_shield" ),
+  info<item_armor_total_data_t>( "item_armor_total" ),
+  info<item_armor_location_data_t>( "item_armor_location" ),
+  info<item_bonus_entry_t>( "item_bonus" ),
+  info<item_child_equipment_t>( "item_child_equipment" ),
+  info<item_damage_one_hand_data_t>( "item_damage_one_hand" ),
+  info<item_damage_one_hand_caster_data_t>( "item_damage_one_hand_caster" ),
+  info<item_damage_two_hand_data_t>( "item_damage_two_hand" ),
+  info<item_damage_two_hand_caster_data_t>( "item_damage_two_hand_caster" ),
+  info<random_prop_data_t>( "rand_prop_points" ),
+  info<rppm_modifier_t>( "rppm_modifier" ),
+  info<spelltext_data_t>( "spelltext", { offsetof( spelltext_data_t, _desc ),
+                                         offsetof( spelltext_data_t, _tooltip ),
+                                         offsetof( spelltext_data_t, _rank ) } ),
+  info<spelldesc_vars_data_t>( "spelldesc_vars", { offsetof( spelldesc_vars_data_t, _desc_vars ) } ),
+} };
+
+// Read-only mapping of the whole bundle file, kept for the lifetime of the process
+class mapping_t
+{
+  const char* _data = nullptr;
+  size_t _size = 0;
+#ifdef SC_WINDOWS
+  HANDLE _mapping = nullptr;
+#endif
+
+public:
+  mapping_t() = default;
+  mapping_t( const mapping_t& ) = delete;
+  mapping_t& operator=( const mapping_t& ) = delete;
+
+  ~mapping_t()
+  { close(); }
+
+  void open( const std::string& path )
+  {
+    close();
+
+#ifdef SC_WINDOWS
+    HANDLE file = CreateFileW( io::widen( path ).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                               OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+    if ( file == INVALID_HANDLE_VALUE )
+    {
+      throw std::runtime_error( fmt::format( "Unable to open client data bundle '{}'.", path ) );
+    }
+
+    LARGE_INTEGER size;
+    if ( GetFileSizeEx( file, &size ) && size.QuadPart > 0 )
+    {
+      _mapping = CreateFileMappingW( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+    }
+    CloseHandle( file );
+
+    if ( _mapping )
+    {
+      _data = static_cast<const char*>( MapViewOfFile( _mapping, FILE_MAP_READ, 0, 0, 0 ) );
+      _size = static_cast<size_t>( size.QuadPart );
+    }
+#else
+    int fd = ::open( path.c_str(), O_RDONLY );
+    if ( fd == -1 )
+    {
+      throw std::runtime_error( fmt::format( "Unable to open client data bundle '{}'.", path ) );
+    }
+
+    struct stat st;
+    if ( fstat( fd, &st ) == 0 && st.st_size > 0 )
+    {
+      void* data = mmap( nullptr, static_cast<size_t>( st.st_size ), PROT_READ, MAP_SHARED, fd, 0 );
+      if ( data != MAP_FAILED )
+      {
+        _data = static_cast<const char*>( data );
+        _size = static_cast<size_t>( st.st_size );
+      }
+    }
+    ::close( fd );
+#endif
+
+    if ( !_data )
+    {
+      close();
+      throw std::runtime_error( fmt::format( "Unable to map client data bundle '{}'.", path ) );
+    }
+  }
+
+  void close()
+  {
+#ifdef SC_WINDOWS
+    if ( _data )
+    {
+      UnmapViewOfFile( _data );
+    }
+    if ( _mapping )
+    {
+      CloseHandle( _mapping );
+      _mapping = nullptr;
+    }
+#else
+    if ( _data )
+    {
+      munmap( const_cast<char*>( _data ), _size );
+    }
+#endif
+    _data = nullptr;
+    _size = 0;
+  }
+
+  const char* data() const
+  { return _data; }
+
+  size_t size() const
+  { return _size; }
+};
+
+struct bundle_state_t
+{
+  mapping_t mapping;
+  header_t header;
+  std::array<std::array<dbc::bundle::table_view_t, 2>, static_cast<size_t>( dbc::bundle::table_e::MAX )> tables;
+  // Records of tables with string fields, copied out of the mapping to point the fields into the
+  // mapped string pool
+  std::vector<std::unique_ptr<char[]>> records;
+  bool loaded = false;
+};
+
+bundle_state_t& state()
+{
+  static bundle_state_t state;
+  return state;
+}
+
+size_t table_index( const directory_entry_t& entry )
+{
+  for ( size_t i = 0; i < tables.size(); ++i )
+  {
+    if ( std::strncmp( entry.name, tables[ i ].name, sizeof( entry.name ) ) == 0 )
+    {
+      return i;
+    }
+  }
+
+  throw std::runtime_error( fmt::format( "Unknown client data table '{}'.",
+        std::string( entry.name, strnlen( entry.name, sizeof( entry.name ) ) ) ) );
+}
+
+void reset_tables( bundle_state_t& s )
+{
+  for ( auto& table : s.tables )
+  {
+    table.fill( { nullptr, 0 } );
+  }
+  s.records.clear();
+}
+
+// Copy the records of a table with string fields, resolving string pool offsets to pointers into
+// the mapped pool
+const char* link_strings( bundle_state_t& s, const table_info_t& table, const char* data, size_t count )
+{
+  const char* strings = s.mapping.data() + s.header.strings_offset;
+  std::unique_ptr<char[]> records( new char[ count * table.element_size ] );
+  std::memcpy( records.get(), data, count * table.element_size );
+
+  for ( size_t i = 0; i < count; ++i )
+  {
+    for ( size_t field : table.strings )
+    {
+      char* slot = records.get() + i * table.element_size + field;
+      uintptr_t offset;
+      std::memcpy( &offset, slot, sizeof( offset ) );
+      if ( offset > s.header.strings_size )
+      {
+        throw std::runtime_error( fmt::format( "Table '{}' has a string out of bounds", table.name ) );
+      }
+
+      const char* str = offset ? strings + offset - 1 : nullptr;
+      std::memcpy( slot, &str, sizeof( str ) );
+    }
+  }
+
+  s.records.push_back( std::move( records ) );
+  return s.records.back().get();
+}
+
+// Copy of the records of a table with string fields, with the fields replaced by the offsets of
+// their strings in pool. Equal strings are stored once.
+std::vector<char> pool_strings( const table_info_t& table, util::span<const char> data,
+                                std::string& pool, std::unordered_map<util::string_view, uintptr_t>& offsets )
+{
+  std::vector<char> records( data.begin(), data.end() );
+  for ( size_t i = 0; i < records.size() / table.element_size; ++i )
+  {
+    for ( size_t field : table.strings )
+    {
+      char* slot = records.data() + i * table.element_size + field;
+      const char* str;
+      std::memcpy( &str, slot, sizeof( str ) );
+
+      uintptr_t offset = 0;
+      if ( str )
+      {
+        auto it = offsets.find( str );
+        if ( it == offsets.end() )
+        {
+          offset = pool.size() + 1;
+          pool.append( str, std::strlen( str ) + 1 );
+          // Keys view the compiled-in strings, which outlive the map
+          it = offsets.emplace( str, offset ).first;
+        }
+        offset = it -> second;
+      }
+      std::memcpy( slot, &offset, sizeof( offset ) );
+    }
+  }
+
+  return records;
+}
+
+void write_padding( std::ostream& out, size_t n )
+{
+  static const char zeroes[ BUNDLE_ALIGNMENT ] = {};
+  out.write( zeroes, n );
+}
+}  // anonymous namespace
+
+void dbc::bundle::load( const std::string& path )
+{
+  auto& s = state();
+  s.loaded = false;
+  reset_tables( s );
+
+  s.mapping.open( path );
+
+  const char* base = s.mapping.data();
+  const size_t size = s.mapping.size();
+
+  try
+  {
+    if ( size < sizeof( header_t ) )
+    {
+      throw std::runtime_error( "Truncated header" );
+    }
+
+    std::memcpy( &s.header, base, sizeof( header_t ) );
+    if ( std::memcmp( s.header.magic, BUNDLE_MAGIC, sizeof( BUNDLE_MAGIC ) ) != 0 )
+    {
+      throw std::runtime_error( "Not a client data bundle" );
+    }
+
+    if ( s.header.byte_order != BUNDLE_BYTE_ORDER )
+    {
+      throw std::runtime_error( "Bundle was written on a platform of different byte order" );
+    }
+
+    if ( s.header.version != BUNDLE_VERSION )
+    {
+      throw std::runtime_error( fmt::format( "Unsupported bundle version {}, expected {}",
+            s.header.version, BUNDLE_VERSION ) );
+    }
+
+    // Hotfixes and the tables that are always compiled-in are keyed to the compiled-in build, so a
+    // bundle of any other build would silently mix data of two builds
+    if ( s.header.build[ 0 ] != dbc::client_data_build( false ) )
+    {
+      throw std::runtime_error( fmt::format( "Bundle was written from client data build {}, expected {}",
+            s.header.build[ 0 ], dbc::client_data_build( false ) ) );
+    }
+
+    if ( SC_USE_PTR && s.header.build[ 1 ] != 0 && s.header.build[ 1 ] != dbc::client_data_build( true ) )
+    {
+      throw std::runtime_error( fmt::format( "Bundle was written from ptr client data build {}, expected {}",
+            s.header.build[ 1 ], dbc::client_data_build( true ) ) );
+    }
+
+    // The pool ends with the terminator of its last string, so every string in it is terminated
+    if ( s.header.strings_offset > size || s.header.strings_size > size - s.header.strings_offset ||
+         ( s.header.strings_size > 0 && base[ s.header.strings_offset + s.header.strings_size - 1 ] != '\0' ) )
+    {
+      throw std::runtime_error( "String pool is out of bounds" );
+    }
+
+    if ( s.header.n_tables > ( size - sizeof( header_t ) ) / sizeof( directory_entry_t ) )
+    {
+      throw std::runtime_error( "Truncated directory" );
+    }
+
+    for ( uint32_t i = 0; i < s.header.n_tables; ++i )
+    {
+      directory_entry_t entry;
+      std::memcpy( &entry, base + sizeof( header_t ) + i * sizeof( directory_entry_t ), sizeof( entry ) );
+
+      size_t idx = table_index( entry );
+      if ( entry.element_size != tables[ idx ].element_size )
+      {
+        throw std::runtime_error( fmt::format( "Table '{}' has record size {}, expected {}",
+              tables[ idx ].name, entry.element_size, tables[ idx ].element_size ) );
+      }
+
+      if ( entry.offset % BUNDLE_ALIGNMENT != 0 || entry.offset > size ||
+           entry.count > ( size - entry.offset ) / entry.element_size )
+      {
+        throw std::runtime_error( fmt::format( "Table '{}' is out of bounds", tables[ idx ].name ) );
+      }
+
+      // Ptr tables of a bundle are ignored by builds without ptr data
+      if ( entry.ptr && !SC_USE_PTR )
+      {
+        continue;
+      }
+
+      const char* data = base + entry.offset;
+      if ( !tables[ idx ].strings.empty() )
+      {
+        data = link_strings( s, tables[ idx ], data, static_cast<size_t>( entry.count ) );
+      }
+
+      s.tables[ idx ][ entry.ptr != 0 ] = { data, static_cast<size_t>( entry.count ) };
+    }
+  }
+  catch ( const std::exception& )
+  {
+    reset_tables( s );
+    s.mapping.close();
+    std::throw_with_nested( std::runtime_error( fmt::format( "Invalid client data bundle '{}'", path ) ) );
+  }
+
+  s.loaded = true;
+}
+
+void dbc::bundle::write( const std::string& path )
+{
+  std::vector<directory_entry_t> directory;
+  std::vector<util::span<const char>> payloads;
+  // Records of tables with string fields, and the pool holding their strings
+  std::vector<std::vector<char>> pooled;
+  std::string pool;
+  std::unordered_map<util::string_view, uintptr_t> pool_offsets;
+
+  for ( bool ptr : { false, true } )
+  {
+    if ( ptr && !SC_USE_PTR )
+    {
+      continue;
+    }
+
+    for ( const auto& table : tables )
+    {
+      directory_entry_t entry {};
+      std::strncpy( entry.name, table.name, sizeof( entry.name ) - 1 );
+      entry.ptr = ptr;
+      entry.element_size = as<uint32_t>( table.element_size );
+      directory.push_back( entry );
+
+      if ( table.strings.empty() )
+      {
+        payloads.push_back( table.data( ptr ) );
+      }
+      else
+      {
+        pooled.push_back( pool_strings( table, table.data( ptr ), pool, pool_offsets ) );
+        payloads.emplace_back( pooled.back().data(), pooled.back().size() );
+      }
+    }
+  }
+
+  header_t header {};
+  std::memcpy( header.magic, BUNDLE_MAGIC, sizeof( BUNDLE_MAGIC ) );
+  header.version = BUNDLE_VERSION;
+  header.byte_order = BUNDLE_BYTE_ORDER;
+  header.n_tables = as<uint32_t>( directory.size() );
+  header.build[ 0 ] = dbc::client_data_build( false );
+  header.build[ 1 ] = SC_USE_PTR ? dbc::client_data_build( true ) : 0;
+
+  auto align = []( uint64_t offset ) {
+    return ( offset + BUNDLE_ALIGNMENT - 1 ) / BUNDLE_ALIGNMENT * BUNDLE_ALIGNMENT;
+  };
+
+  uint64_t offset = align( sizeof( header_t ) + directory.size() * sizeof( directory_entry_t ) );
+  for ( size_t i = 0; i < directory.size(); ++i )
+  {
+    directory[ i ].offset = offset;
+    directory[ i ].count = payloads[ i ].size() / directory[ i ].element_size;
+    offset = align( offset + payloads[ i ].size() );
+  }
+  header.strings_offset = offset;
+  header.strings_size = pool.size();
+
+  io::ofstream out;
+  out.open( path, std::ios::out | std::ios::trunc | std::ios::binary );
+  if ( !out.is_open() )
+  {
+    throw std::runtime_error( fmt::format( "Unable to open client data bundle '{}' for writing.", path ) );
+  }
+
+  out.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+  out.write( reinterpret_cast<const char*>( directory.data() ), directory.size() * sizeof( directory_entry_t ) );
+
+  uint64_t position = sizeof( header_t ) + directory.size() * sizeof( directory_entry_t );
+  for ( size_t i = 0; i < directory.size(); ++i )
+  {
+    write_padding( out, static_cast<size_t>( directory[ i ].offset - position ) );
+    out.write( payloads[ i ].data(), payloads[ i ].size() );
+    position = directory[ i ].offset + payloads[ i ].size();
+  }
+  write_padding( out, static_cast<size_t>( header.strings_offset - position ) );
+  out.write( pool.data(), pool.size() );
+
+  if ( !out )
+  {
+    throw std::runtime_error( fmt::format( "Unable to write client data bundle '{}'.", path ) );
+  }
+}
+
+bool dbc::bundle::loaded()
+{
+  return state().loaded;
+}
+
+int dbc::bundle::build( bool ptr )
+{
+  const auto& s = state();
+  return s.loaded ? s.header.build[ SC_USE_PTR && ptr ] : 0;
+}
+
+const dbc::bundle::table_view_t& dbc::bundle::table( table_e t, bool ptr )
+{
+  return state().tables[ static_cast<size_t>( t ) ][ SC_USE_PTR && ptr ];
+}
@@ -0,0 +1,99 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+#ifndef SC_DBC_DATA_BUNDLE_HPP
+#define SC_DBC_DATA_BUNDLE_HPP
+
+#include "config.hpp"
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+
+#include "util/span.hpp"
+
+#include "client_data.hpp"
+
+/* Binary client data bundle
+ *
+ * A bundle is a versioned binary file holding client data tables as offset-addressed arrays of
+ * their in-memory records. It is mapped read-only at startup ( dbc_bundle= ), and the tables it
+ * contains are then used in place of the compiled-in ones. Since the mapping is shared, the pages of
+ * the bundle are shared by all simc processes using the same file. A bundle is only accepted by
+ * builds of the same client data build.
+ *
+ * Strings of the bundled tables are stored once in a string pool, and the string fields of their
+ * records as offsets into it. The records of such tables are copied at load to point the fields
+ * into the mapped pool; the strings themselves are not copied. Tables with links to other tables
+ * (spells, items) are always compiled-in. Tables missing from the bundle fall back to the
+ * compiled-in data.
+ */
+namespace dbc
+{
+namespace bundle
+{
+// Bundled tables. The order is the order of the directory of written bundles, new tables go to
+// the end.
+enum class table_e : unsigned
+{
+  CURVE_POINT = 0,
+  GEM_PROPERTY,
+  ITEM_ARMOR_QUALITY,
+  ITEM_ARMOR_SHIELD,
+  ITEM_ARMOR_TOTAL,
+  ITEM_ARMOR_LOCATION,
+  ITEM_BONUS,
+  ITEM_CHILD_EQUIPMENT,
+  ITEM_DAMAGE_ONE_HAND,
+  ITEM_DAMAGE_ONE_HAND_CASTER,
+  ITEM_DAMAGE_TWO_HAND,
+  ITEM_DAMAGE_TWO_HAND_CASTER,
+  RAND_PROP_POINTS,
+  RPPM_MODIFIER,
+  SPELLTEXT,
+  SPELLDESC_VARS,
+  MAX
+};
+
+struct table_view_t
+{
+  const void* data;
+  size_t      size;
+};
+
+// Map the bundle file at path, replacing the compiled-in data of the tables it contains. Has to be
+// called before any of the tables is accessed.
+void load( const std::string& path );
+
+// Write the current data of all bundled tables to path
+void write( const std::string& path );
+
+bool loaded();
+
+// Client data build the loaded bundle was written from, or 0 if no bundle is loaded
+int build( bool ptr );
+
+// Table of the loaded bundle, data is nullptr if the table is not bundled
+const table_view_t& table( table_e t, bool ptr );
+
+template <typename T, size_t N>
+util::span<const T> data( table_e t, util::span<const T, N> compiled, bool ptr )
+{
+  static_assert( std::is_trivially_copyable<T>::value, "Bundled client data has to be trivially copyable" );
+
+  const auto& view = table( t, ptr );
+  if ( view.data )
+  {
+    return util::span<const T>( static_cast<const T*>( view.data ), view.size );
+  }
+
+  return compiled;
+}
+}  // namespace bundle
+}  // namespace dbc
+
+#define SC_DBC_GET_BUNDLED_DATA( _table__, _data__, _data_ptr__, _ptr_flag__ ) \
+    ::dbc::bundle::data( ::dbc::bundle::table_e::_table__, SC_DBC_GET_DATA( _data__, _data_ptr__, _ptr_flag__ ), _ptr_flag__ )
+
+#endif /* SC_DBC_DATA_BUNDLE_HPP */
@@ -3,6 +3,7 @@
 #include "config.hpp"
 
 #include "gem_data.hpp"
+#include "data_bundle.hpp"
 
 #include "generated/gem_data.inc"
 #if SC_USE_PTR == 1
@@ -11,7 +12,7 @@
 
 util::span<const gem_property_data_t> gem_property_data_t::data( bool ptr )
 {
-  return SC_DBC_GET_DATA( __gem_property_data, __ptr_gem_property_data, ptr );
+  return SC_DBC_GET_BUNDLED_DATA( GEM_PROPERTY, __gem_property_data, __ptr_gem_property_data, ptr );
 }
 
 
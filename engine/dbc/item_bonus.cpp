@@ -3,6 +3,7 @@
 #include "config.hpp"
 
 #include "item_bonus.hpp"
+#include "data_bundle.hpp"
 
 #include "util/generic.hpp"
 
@@ -13,7 +14,7 @@
 
 util::span<const item_bonus_entry_t> item_bonus_entry_t::data( bool ptr )
 {
-  return SC_DBC_GET_DATA( __item_bonus_data, __ptr_item_bonus_data, ptr );
+  return SC_DBC_GET_BUNDLED_DATA( ITEM_BONUS, __item_bonus_data, __ptr_item_bonus_data, ptr );
 }
 
 util::span<const item_bonus_entry_t> item_bonus_entry_t::find( unsigned bonus_id, bool ptr )
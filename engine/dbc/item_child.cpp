@@ -3,6 +3,7 @@
 #include "config.hpp"
 
 #include "item_child.hpp"
+#include "data_bundle.hpp"
 
 #include "generated/item_child.inc"
 #if SC_USE_PTR == 1
@@ -11,7 +12,7 @@
 
 util::span<const item_child_equipment_t> item_child_equipment_t::data( bool ptr )
 {
-  return SC_DBC_GET_DATA( __item_child_equipment_data, __ptr_item_child_equipment_data, ptr );
+  return SC_DBC_GET_BUNDLED_DATA( ITEM_CHILD_EQUIPMENT, __item_child_equipment_data, __ptr_item_child_equipment_data, ptr );
 }
 
 
@@ -3,6 +3,7 @@
 #include "config.hpp"
 
 #include "item_scaling.hpp"
+#include "data_bundle.hpp"
 
 #include "util/generic.hpp"
 
@@ -13,7 +14,7 @@
 
 util::span<const curve_point_t> curve_point_t::data( bool ptr )
 {
-  return SC_DBC_GET_DATA( __curve_point_data, __ptr_curve_point_data, ptr );
+  return SC_DBC_GET_BUNDLED_DATA( CURVE_POINT, __curve_point_data, __ptr_curve_point_data, ptr );
 }
 
 util::span<const curve_point_t> curve_point_t::find( unsigned id, bool ptr )
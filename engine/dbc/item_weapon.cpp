@@ -3,6 +3,7 @@
 #include "config.hpp"
 
 #include "item_weapon.hpp"
+#include "data_bundle.hpp"
 
 #include "generated/item_weapon.inc"
 #if SC_USE_PTR == 1
@@ -11,21 +12,21 @@
 
 util::span<const item_damage_one_hand_data_t> item_damage_one_hand_data_t::data( bool ptr )
 {
-  return SC_DBC_GET_DATA( __item_damage_one_hand_data, __ptr_item_damage_one_hand_data, ptr );
+  return SC_DBC_GET_BUNDLED_DATA( ITEM_DAMAGE_ONE_HAND, __item_damage_one_hand_data, __ptr_item_damage_one_hand_data, ptr );
 }
 
 util::span<const item_damage_one_hand_caster_data_t> item_damage_one_hand_caster_data_t::data( bool ptr )
 {
-  return SC_DBC_GET_DATA( __item_damage_one_hand_caster_data, __ptr_item_damage_one_hand_caster_data, ptr );
+  return SC_DBC_GET_BUNDLED_DATA( ITEM_DAMAGE_ONE_HAND_CASTER, __item_damage_one_hand_caster_data, __ptr_item_damage_one_hand_caster_data, ptr );
 }
 
 util::span<const item_damage_two_hand_data_t> item_damage_two_hand_data_t::data( bool ptr )
 {
-  return SC_DBC_GET_DATA( __item_damage_two_hand_data, __ptr_item_damage_two_hand_data, ptr );
+  return SC_DBC_GET_BUNDLED_DATA( ITEM_DAMAGE_TWO_HAND, __item_damage_two_hand_data, __ptr_item_damage_two_hand_data, ptr );
 }
 
 util::span<const item_damage_two_hand_caster_data_t> item_damage_two_hand_caster_data_t::data( bool ptr )
 {
-  return SC_DBC_GET_DATA( __item_damage_two_hand_caster_data, __ptr_item_damage_two_hand_caster_data, ptr );
+  return SC_DBC_GET_BUNDLED_DATA( ITEM_DAMAGE_TWO_HAND_CASTER, __item_damage_two_hand_caster_data, __ptr_item_damage_two_hand_caster_data, ptr );
 }
 
@@ -3,6 +3,7 @@
 #include "config.hpp"
 
 #include "rand_prop_points.hpp"
+#include "data_bundle.hpp"
 
 #include "generated/rand_prop_points.inc"
 #if SC_USE_PTR == 1
@@ -11,6 +12,6 @@
 
 util::span<const random_prop_data_t> random_prop_data_t::data( bool ptr )
 {
-  return SC_DBC_GET_DATA( __rand_prop_points_data, __ptr_rand_prop_points_data, ptr );
+  return SC_DBC_GET_BUNDLED_DATA( RAND_PROP_POINTS, __rand_prop_points_data, __ptr_rand_prop_points_data, ptr );
 }
 
@@ -3,6 +3,7 @@
 #include "config.hpp"
 
 #include "real_ppm_data.hpp"
+#include "data_bundle.hpp"
 
 #include "generated/real_ppm_data.inc"
 #if SC_USE_PTR == 1
@@ -11,5 +12,5 @@
 
 util::span<const rppm_modifier_t> rppm_modifier_t::data( bool ptr )
 {
-  return SC_DBC_GET_DATA( __rppm_modifier_data, __ptr_rppm_modifier_data, ptr );
+  return SC_DBC_GET_BUNDLED_DATA( RPPM_MODIFIER, __rppm_modifier_data, __ptr_rppm_modifier_data, ptr );
 }
@@ -189,6 +189,12 @@ static void generate_indices( bool ptr )
       }
     }
   }
+
+  // Name indices for the spell and ability lookups of class modules
+  spell_data_t::init_name_index( ptr );
+  talent_data_t::init_name_index( ptr );
+  active_class_spell_t::init_name_index( ptr );
+  active_pet_spell_t::init_name_index( ptr );
 }
 
 /* Initialize database
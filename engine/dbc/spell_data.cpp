@@ -480,8 +480,26 @@ const spell_data_t* spell_data_t::find( unsigned spell_id, util::string_view con
   return p;
 }
 
+namespace
+{
+// Spell names point to the generated data, so the index does not copy them
+dbc::name_dbc_index_t<spell_data_t, util::string_view> spell_name_index;
+}  // unnamed namespace
+
+void spell_data_t::init_name_index( bool ptr )
+{
+  spell_name_index.init( data( ptr ), ptr, []( const spell_data_t& spell ) {
+    return util::string_view( spell.name_cstr() );
+  } );
+}
+
 const spell_data_t* spell_data_t::find( util::string_view name, bool ptr )
 {
+  if ( spell_name_index.initialized( ptr ) )
+  {
+    return spell_name_index.find( name, ptr, []( const spell_data_t& ) { return true; } );
+  }
+
   const auto __data = data( ptr );
   auto it = range::find( __data, name, &spell_data_t::name_cstr );
   if ( it != __data.end() )
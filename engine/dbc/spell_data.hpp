@@ -757,6 +757,7 @@ struct spell_data_t
   static util::span<const hotfix::client_hotfix_entry_t> hotfixes( const spell_data_t&, bool ptr );
 
   static void link( bool ptr );
+  static void init_name_index( bool ptr );
 private:
   static util::span<spell_data_t> _data( bool ptr );
 };
@@ -1,5 +1,6 @@
 
 #include "spelltext_data.hpp"
+#include "data_bundle.hpp"
 
 #include <array>
 
@@ -10,7 +11,7 @@
 
 util::span<const spelltext_data_t> spelltext_data_t::data( bool ptr )
 {
-  return SC_DBC_GET_DATA( __spelltext_data, __ptr_spelltext_data, ptr );
+  return SC_DBC_GET_BUNDLED_DATA( SPELLTEXT, __spelltext_data, __ptr_spelltext_data, ptr );
 }
 
 util::span<const hotfix::client_hotfix_entry_t> spelltext_data_t::hotfixes( const spelltext_data_t& std, bool ptr )
@@ -21,7 +22,7 @@ util::span<const hotfix::client_hotfix_entry_t> spelltext_data_t::hotfixes( cons
 
 util::span<const spelldesc_vars_data_t> spelldesc_vars_data_t::data( bool ptr )
 {
-  return SC_DBC_GET_DATA( __spelldesc_vars_data, __ptr_spelldesc_vars_data, ptr );
+  return SC_DBC_GET_BUNDLED_DATA( SPELLDESC_VARS, __spelldesc_vars_data, __ptr_spelldesc_vars_data, ptr );
 }
 
 util::span<const hotfix::client_hotfix_entry_t> spelldesc_vars_data_t::hotfixes( const spelldesc_vars_data_t& sdvd, bool ptr )
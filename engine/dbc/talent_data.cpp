@@ -39,8 +39,32 @@ const talent_data_t* talent_data_t::find( unsigned id, util::string_view confirm
   return p;
 }
 
+namespace
+{
+dbc::name_dbc_index_t<talent_data_t, util::string_view> talent_name_index;
+// Tokenized names are compared case insensitively, so they are indexed in lower case
+dbc::name_dbc_index_t<talent_data_t> talent_token_index;
+}  // unnamed namespace
+
+void talent_data_t::init_name_index( bool ptr )
+{
+  talent_name_index.init( data( ptr ), ptr, []( const talent_data_t& td ) {
+    return util::string_view( td.name_cstr() );
+  } );
+  talent_token_index.init( data( ptr ), ptr, []( const talent_data_t& td ) {
+    return util::tokenize_fn( td.name_cstr() );
+  } );
+}
+
 const talent_data_t* talent_data_t::find( util::string_view name, specialization_e spec, bool ptr )
 {
+  if ( talent_name_index.initialized( ptr ) )
+  {
+    return talent_name_index.find( name, ptr, [ spec ]( const talent_data_t& td ) {
+      return td.specialization() == spec;
+    } );
+  }
+
   for ( const talent_data_t& td : data( ptr ) )
   {
     if ( td.specialization() == spec && name == td.name_cstr() )
@@ -51,6 +75,15 @@ const talent_data_t* talent_data_t::find( util::string_view name, specialization
 
 const talent_data_t* talent_data_t::find_tokenized( util::string_view name, specialization_e spec, bool ptr )
 {
+  if ( talent_token_index.initialized( ptr ) )
+  {
+    std::string key( name );
+    util::tolower( key );
+    return talent_token_index.find( key, ptr, [ spec ]( const talent_data_t& td ) {
+      return td.specialization() == spec;
+    } );
+  }
+
   for ( const talent_data_t& td : data( ptr ) )
   {
     auto tokenized_name = util::tokenize_fn( td.name_cstr() );
@@ -71,6 +71,7 @@ struct talent_data_t
   static const talent_data_t* find( player_e c, unsigned int row, unsigned int col, specialization_e spec, bool ptr = false );
   static util::span<const talent_data_t> data( bool ptr = false );
   static void link( bool ptr = false );
+  static void init_name_index( bool ptr = false );
 private:
   static util::span<talent_data_t> _data( bool ptr );
 };
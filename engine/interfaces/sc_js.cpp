@@ -246,6 +246,10 @@ namespace js {
     if (!v.simple)
     {
       v_.AddMember(rapidjson::StringRef("median"), v.percentile(0.5), d_.GetAllocator());
+      if (v.approximate())
+      {
+        v_.AddMember(rapidjson::StringRef("approximate"), true, d_.GetAllocator());
+      }
       v_.AddMember(rapidjson::StringRef("variance"), v.variance, d_.GetAllocator());
       v_.AddMember(rapidjson::StringRef("std_dev"), v.std_dev, d_.GetAllocator());
       v_.AddMember(rapidjson::StringRef("mean_variance"), v.mean_variance, d_.GetAllocator());
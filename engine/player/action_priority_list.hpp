@@ -49,9 +49,12 @@ struct action_priority_list_t
   std::vector<action_t*> off_gcd_actions;
   std::vector<action_t*> cast_while_casting_actions;
   int random; // Used to determine how faceroll something actually is. :D
+  // If expressions evaluated, and memoized results reused instead ( sim option memoize_conditions )
+  uint64_t condition_evaluations, condition_reuses;
   action_priority_list_t(util::string_view name, player_t* p, util::string_view list_comment = {}) :
     internal_id(0), internal_id_mask(0), name_str(name), action_list_comment_str(list_comment), player(p), used(false),
-    foreground_action_list(), off_gcd_actions(), cast_while_casting_actions(), random(0)
+    foreground_action_list(), off_gcd_actions(), cast_while_casting_actions(), random(0),
+    condition_evaluations(0), condition_reuses(0)
   { }
 
   action_priority_t* add_action(util::string_view action_priority_str, util::string_view comment = {});
@@ -15,6 +15,7 @@ action_variable_t::action_variable_t( const std::string& name, double default_va
   : current_value_( default_value ),
     default_value_( default_value ),
     constant_value_( std::numeric_limits<double>::lowest() ),
+    version_( 0 ),
     name_( name )
 {
 }
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -13,6 +14,7 @@ struct action_t;
 struct action_variable_t
 {
   double current_value_, default_value_, constant_value_;
+  uint64_t version_; // Bumped on every change to the current value, see expr_t::depends_on
   std::string name_;
   std::vector<action_t*> variable_actions;
 
@@ -25,7 +27,11 @@ struct action_variable_t
 
   void reset()
   {
-    current_value_ = default_value_;
+    if ( current_value_ != default_value_ )
+    {
+      current_value_ = default_value_;
+      version_++;
+    }
   }
 
   bool is_constant( double* constant_value ) const;
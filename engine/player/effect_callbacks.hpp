@@ -29,8 +29,10 @@ struct effect_callbacks_t
   typedef std::array<proc_on_array_t, PROC1_TYPE_MAX> proc_array_t;
 
   proc_array_t procs;
+  // Incremented whenever procs changes, to invalidate the proc dispatch tables of actions
+  unsigned version;
 
-  effect_callbacks_t( sim_t* sim ) : sim( sim )
+  effect_callbacks_t( sim_t* sim ) : sim( sim ), version( 0 )
   { }
 
   bool has_callback( const std::function<bool(const T_CB*)> cmp ) const
@@ -70,6 +72,8 @@ void effect_callbacks_t<T_CB>::add_proc_callback(proc_types type,
   if (sim->debug)
     s += "Registering procs: ";
 
+  version++;
+
   // Setup the proc-on-X types for the proc
   for (proc_types2 pt = PROC2_TYPE_MIN; pt < PROC2_TYPE_MAX; pt++)
   {
@@ -9,6 +9,13 @@
 #include "action/sc_action.hpp"
 
 
+player_stat_cache_t::player_stat_cache_t( const player_t* p )
+  : player( p ), hits(), misses(), count_hits( false ), dispatched( CACHE_MAX ), active( false )
+{
+  // Until the linked invalidations are compiled, any invalidation clears every cache
+  range::fill( keep_mask, mask_t() );
+}
+
 /**
  * Invalidate cache for ALL stats.
  */
@@ -17,32 +24,54 @@ void player_stat_cache_t::invalidate_all()
   if ( !active )
     return;
 
-  range::fill( valid, false );
-  range::fill( spell_power_valid, false );
-  range::fill( player_mult_valid, false );
-  range::fill( player_heal_mult_valid, false );
+  valid.reset();
+}
+
+/**
+ * Set the 'valid'-states cleared by an invalidation of the given cache, and its linked invalidations.
+ */
+void player_stat_cache_t::set_invalidation( cache_e c, const mask_t& m, std::vector<cache_e> linked )
+{
+  keep_mask[ c ]     = ~m;
+  linked_caches[ c ] = std::move( linked );
 }
 
 /**
- * Invalidate cache for a specific cache.
+ * 'valid'-states of a single cache, without any linked invalidations.
  */
-void player_stat_cache_t::invalidate( cache_e c )
+player_stat_cache_t::mask_t player_stat_cache_t::mask( cache_e c )
 {
+  mask_t m;
+
   switch ( c )
   {
     case CACHE_SPELL_POWER:
-      range::fill( spell_power_valid, false );
+      for ( unsigned i = 0; i < SCHOOL_MAX + 1; ++i )
+        m.set( SPELL_POWER_VALID + i );
       break;
     case CACHE_PLAYER_DAMAGE_MULTIPLIER:
-      range::fill( player_mult_valid, false );
+      for ( unsigned i = 0; i < SCHOOL_MAX + 1; ++i )
+        m.set( PLAYER_MULT_VALID + i );
       break;
     case CACHE_PLAYER_HEAL_MULTIPLIER:
-      range::fill( player_heal_mult_valid, false );
+      for ( unsigned i = 0; i < SCHOOL_MAX + 1; ++i )
+        m.set( PLAYER_HEAL_MULT_VALID + i );
       break;
     default:
-      valid[ c ] = false;
+      m.set( c );
       break;
   }
+
+  return m;
+}
+
+void player_stat_cache_t::merge( const player_stat_cache_t& other )
+{
+  for ( size_t i = 0; i < hits.size(); ++i )
+  {
+    hits[ i ] += other.hits[ i ];
+    misses[ i ] += other.misses[ i ];
+  }
 }
 
 /**
@@ -73,7 +102,7 @@ double player_stat_cache_t::get_attribute( attribute_e a ) const
 
 double player_stat_cache_t::strength() const
 {
-  if ( !active || !valid[ CACHE_STRENGTH ] )
+  if ( !active || !check( CACHE_STRENGTH ) )
   {
     valid[ CACHE_STRENGTH ] = true;
     _strength               = player->strength();
@@ -85,7 +114,7 @@ double player_stat_cache_t::strength() const
 
 double player_stat_cache_t::agility() const
 {
-  if ( !active || !valid[ CACHE_AGILITY ] )
+  if ( !active || !check( CACHE_AGILITY ) )
   {
     valid[ CACHE_AGILITY ] = true;
     _agility               = player->agility();
@@ -97,7 +126,7 @@ double player_stat_cache_t::agility() const
 
 double player_stat_cache_t::stamina() const
 {
-  if ( !active || !valid[ CACHE_STAMINA ] )
+  if ( !active || !check( CACHE_STAMINA ) )
   {
     valid[ CACHE_STAMINA ] = true;
     _stamina               = player->stamina();
@@ -109,7 +138,7 @@ double player_stat_cache_t::stamina() const
 
 double player_stat_cache_t::intellect() const
 {
-  if ( !active || !valid[ CACHE_INTELLECT ] )
+  if ( !active || !check( CACHE_INTELLECT ) )
   {
     valid[ CACHE_INTELLECT ] = true;
     _intellect               = player->intellect();
@@ -121,7 +150,7 @@ double player_stat_cache_t::intellect() const
 
 double player_stat_cache_t::spirit() const
 {
-  if ( !active || !valid[ CACHE_SPIRIT ] )
+  if ( !active || !check( CACHE_SPIRIT ) )
   {
     valid[ CACHE_SPIRIT ] = true;
     _spirit               = player->spirit();
@@ -133,10 +162,10 @@ double player_stat_cache_t::spirit() const
 
 double player_stat_cache_t::spell_power( school_e s ) const
 {
-  if ( !active || !spell_power_valid[ s ] )
+  if ( !active || !check( SPELL_POWER_VALID + s, CACHE_SPELL_POWER ) )
   {
-    spell_power_valid[ s ] = true;
-    _spell_power[ s ]      = player->composite_spell_power( s );
+    valid[ SPELL_POWER_VALID + s ] = true;
+    _spell_power[ s ]              = player->composite_spell_power( s );
   }
   else
     assert( _spell_power[ s ] == player->composite_spell_power( s ) );
@@ -145,7 +174,7 @@ double player_stat_cache_t::spell_power( school_e s ) const
 
 double player_stat_cache_t::attack_power() const
 {
-  if ( !active || !valid[ CACHE_ATTACK_POWER ] )
+  if ( !active || !check( CACHE_ATTACK_POWER ) )
   {
     valid[ CACHE_ATTACK_POWER ] = true;
     _attack_power               = player->composite_melee_attack_power();
@@ -157,7 +186,7 @@ double player_stat_cache_t::attack_power() const
 
 double player_stat_cache_t::attack_expertise() const
 {
-  if ( !active || !valid[ CACHE_ATTACK_EXP ] )
+  if ( !active || !check( CACHE_ATTACK_EXP ) )
   {
     valid[ CACHE_ATTACK_EXP ] = true;
     _attack_expertise         = player->composite_melee_expertise();
@@ -169,7 +198,7 @@ double player_stat_cache_t::attack_expertise() const
 
 double player_stat_cache_t::attack_hit() const
 {
-  if ( !active || !valid[ CACHE_ATTACK_HIT ] )
+  if ( !active || !check( CACHE_ATTACK_HIT ) )
   {
     valid[ CACHE_ATTACK_HIT ] = true;
     _attack_hit               = player->composite_melee_hit();
@@ -187,7 +216,7 @@ double player_stat_cache_t::attack_hit() const
 
 double player_stat_cache_t::attack_crit_chance() const
 {
-  if ( !active || !valid[ CACHE_ATTACK_CRIT_CHANCE ] )
+  if ( !active || !check( CACHE_ATTACK_CRIT_CHANCE ) )
   {
     valid[ CACHE_ATTACK_CRIT_CHANCE ] = true;
     _attack_crit_chance               = player->composite_melee_crit_chance();
@@ -199,7 +228,7 @@ double player_stat_cache_t::attack_crit_chance() const
 
 double player_stat_cache_t::attack_haste() const
 {
-  if ( !active || !valid[ CACHE_ATTACK_HASTE ] )
+  if ( !active || !check( CACHE_ATTACK_HASTE ) )
   {
     valid[ CACHE_ATTACK_HASTE ] = true;
     _attack_haste               = player->composite_melee_haste();
@@ -211,7 +240,7 @@ double player_stat_cache_t::attack_haste() const
 
 double player_stat_cache_t::attack_speed() const
 {
-  if ( !active || !valid[ CACHE_ATTACK_SPEED ] )
+  if ( !active || !check( CACHE_ATTACK_SPEED ) )
   {
     valid[ CACHE_ATTACK_SPEED ] = true;
     _attack_speed               = player->composite_melee_speed();
@@ -223,7 +252,7 @@ double player_stat_cache_t::attack_speed() const
 
 double player_stat_cache_t::spell_hit() const
 {
-  if ( !active || !valid[ CACHE_SPELL_HIT ] )
+  if ( !active || !check( CACHE_SPELL_HIT ) )
   {
     valid[ CACHE_SPELL_HIT ] = true;
     _spell_hit               = player->composite_spell_hit();
@@ -235,7 +264,7 @@ double player_stat_cache_t::spell_hit() const
 
 double player_stat_cache_t::spell_crit_chance() const
 {
-  if ( !active || !valid[ CACHE_SPELL_CRIT_CHANCE ] )
+  if ( !active || !check( CACHE_SPELL_CRIT_CHANCE ) )
   {
     valid[ CACHE_SPELL_CRIT_CHANCE ] = true;
     _spell_crit_chance               = player->composite_spell_crit_chance();
@@ -247,7 +276,7 @@ double player_stat_cache_t::spell_crit_chance() const
 
 double player_stat_cache_t::rppm_haste_coeff() const
 {
-  if ( !active || !valid[ CACHE_RPPM_HASTE ] )
+  if ( !active || !check( CACHE_RPPM_HASTE ) )
   {
     valid[ CACHE_RPPM_HASTE ] = true;
     _rppm_haste_coeff          = 1.0 / std::min( player->cache.spell_haste(), player->cache.attack_haste() );
@@ -261,7 +290,7 @@ double player_stat_cache_t::rppm_haste_coeff() const
 
 double player_stat_cache_t::rppm_crit_coeff() const
 {
-  if ( !active || !valid[ CACHE_RPPM_CRIT ] )
+  if ( !active || !check( CACHE_RPPM_CRIT ) )
   {
     valid[ CACHE_RPPM_CRIT ] = true;
     _rppm_crit_coeff          = 1.0 + std::max( player->cache.attack_crit_chance(), player->cache.spell_crit_chance() );
@@ -275,7 +304,7 @@ double player_stat_cache_t::rppm_crit_coeff() const
 
 double player_stat_cache_t::spell_haste() const
 {
-  if ( !active || !valid[ CACHE_SPELL_HASTE ] )
+  if ( !active || !check( CACHE_SPELL_HASTE ) )
   {
     valid[ CACHE_SPELL_HASTE ] = true;
     _spell_haste               = player->composite_spell_haste();
@@ -287,7 +316,7 @@ double player_stat_cache_t::spell_haste() const
 
 double player_stat_cache_t::spell_speed() const
 {
-  if ( !active || !valid[ CACHE_SPELL_SPEED ] )
+  if ( !active || !check( CACHE_SPELL_SPEED ) )
   {
     valid[ CACHE_SPELL_SPEED ] = true;
     _spell_speed               = player->composite_spell_speed();
@@ -299,7 +328,7 @@ double player_stat_cache_t::spell_speed() const
 
 double player_stat_cache_t::dodge() const
 {
-  if ( !active || !valid[ CACHE_DODGE ] )
+  if ( !active || !check( CACHE_DODGE ) )
   {
     valid[ CACHE_DODGE ] = true;
     _dodge               = player->composite_dodge();
@@ -311,7 +340,7 @@ double player_stat_cache_t::dodge() const
 
 double player_stat_cache_t::parry() const
 {
-  if ( !active || !valid[ CACHE_PARRY ] )
+  if ( !active || !check( CACHE_PARRY ) )
   {
     valid[ CACHE_PARRY ] = true;
     _parry               = player->composite_parry();
@@ -323,7 +352,7 @@ double player_stat_cache_t::parry() const
 
 double player_stat_cache_t::block() const
 {
-  if ( !active || !valid[ CACHE_BLOCK ] )
+  if ( !active || !check( CACHE_BLOCK ) )
   {
     valid[ CACHE_BLOCK ] = true;
     _block               = player->composite_block();
@@ -335,7 +364,7 @@ double player_stat_cache_t::block() const
 
 double player_stat_cache_t::crit_block() const
 {
-  if ( !active || !valid[ CACHE_CRIT_BLOCK ] )
+  if ( !active || !check( CACHE_CRIT_BLOCK ) )
   {
     valid[ CACHE_CRIT_BLOCK ] = true;
     _crit_block               = player->composite_crit_block();
@@ -347,7 +376,7 @@ double player_stat_cache_t::crit_block() const
 
 double player_stat_cache_t::crit_avoidance() const
 {
-  if ( !active || !valid[ CACHE_CRIT_AVOIDANCE ] )
+  if ( !active || !check( CACHE_CRIT_AVOIDANCE ) )
   {
     valid[ CACHE_CRIT_AVOIDANCE ] = true;
     _crit_avoidance               = player->composite_crit_avoidance();
@@ -359,7 +388,7 @@ double player_stat_cache_t::crit_avoidance() const
 
 double player_stat_cache_t::miss() const
 {
-  if ( !active || !valid[ CACHE_MISS ] )
+  if ( !active || !check( CACHE_MISS ) )
   {
     valid[ CACHE_MISS ] = true;
     _miss               = player->composite_miss();
@@ -371,7 +400,7 @@ double player_stat_cache_t::miss() const
 
 double player_stat_cache_t::armor() const
 {
-  if ( !active || !valid[ CACHE_ARMOR ] || !valid[ CACHE_BONUS_ARMOR ] )
+  if ( !active || !check( CACHE_ARMOR ) || !valid[ CACHE_BONUS_ARMOR ] )
   {
     valid[ CACHE_ARMOR ] = true;
     _armor               = player->composite_armor();
@@ -383,7 +412,7 @@ double player_stat_cache_t::armor() const
 
 double player_stat_cache_t::mastery() const
 {
-  if ( !active || !valid[ CACHE_MASTERY ] )
+  if ( !active || !check( CACHE_MASTERY ) )
   {
     valid[ CACHE_MASTERY ] = true;
     _mastery               = player->composite_mastery();
@@ -401,7 +430,7 @@ double player_stat_cache_t::mastery() const
  */
 double player_stat_cache_t::mastery_value() const
 {
-  if ( !active || !valid[ CACHE_MASTERY ] )
+  if ( !active || !check( CACHE_MASTERY ) )
   {
     valid[ CACHE_MASTERY ] = true;
     _mastery               = player->composite_mastery();
@@ -414,7 +443,7 @@ double player_stat_cache_t::mastery_value() const
 
 double player_stat_cache_t::bonus_armor() const
 {
-  if ( !active || !valid[ CACHE_BONUS_ARMOR ] )
+  if ( !active || !check( CACHE_BONUS_ARMOR ) )
   {
     valid[ CACHE_BONUS_ARMOR ] = true;
     _bonus_armor               = player->composite_bonus_armor();
@@ -426,7 +455,7 @@ double player_stat_cache_t::bonus_armor() const
 
 double player_stat_cache_t::damage_versatility() const
 {
-  if ( !active || !valid[ CACHE_DAMAGE_VERSATILITY ] )
+  if ( !active || !check( CACHE_DAMAGE_VERSATILITY ) )
   {
     valid[ CACHE_DAMAGE_VERSATILITY ] = true;
     _damage_versatility               = player->composite_damage_versatility();
@@ -438,7 +467,7 @@ double player_stat_cache_t::damage_versatility() const
 
 double player_stat_cache_t::heal_versatility() const
 {
-  if ( !active || !valid[ CACHE_HEAL_VERSATILITY ] )
+  if ( !active || !check( CACHE_HEAL_VERSATILITY ) )
   {
     valid[ CACHE_HEAL_VERSATILITY ] = true;
     _heal_versatility               = player->composite_heal_versatility();
@@ -450,7 +479,7 @@ double player_stat_cache_t::heal_versatility() const
 
 double player_stat_cache_t::mitigation_versatility() const
 {
-  if ( !active || !valid[ CACHE_MITIGATION_VERSATILITY ] )
+  if ( !active || !check( CACHE_MITIGATION_VERSATILITY ) )
   {
     valid[ CACHE_MITIGATION_VERSATILITY ] = true;
     _mitigation_versatility               = player->composite_mitigation_versatility();
@@ -462,7 +491,7 @@ double player_stat_cache_t::mitigation_versatility() const
 
 double player_stat_cache_t::leech() const
 {
-  if ( !active || !valid[ CACHE_LEECH ] )
+  if ( !active || !check( CACHE_LEECH ) )
   {
     valid[ CACHE_LEECH ] = true;
     _leech               = player->composite_leech();
@@ -474,7 +503,7 @@ double player_stat_cache_t::leech() const
 
 double player_stat_cache_t::run_speed() const
 {
-  if ( !active || !valid[ CACHE_RUN_SPEED ] )
+  if ( !active || !check( CACHE_RUN_SPEED ) )
   {
     valid[ CACHE_RUN_SPEED ] = true;
     _run_speed               = player->composite_movement_speed();
@@ -486,7 +515,7 @@ double player_stat_cache_t::run_speed() const
 
 double player_stat_cache_t::avoidance() const
 {
-  if ( !active || !valid[ CACHE_AVOIDANCE ] )
+  if ( !active || !check( CACHE_AVOIDANCE ) )
   {
     valid[ CACHE_AVOIDANCE ] = true;
     _avoidance               = player->composite_avoidance();
@@ -498,7 +527,7 @@ double player_stat_cache_t::avoidance() const
 
 double player_stat_cache_t::corruption() const
 {
-  if ( !active || !valid[ CACHE_CORRUPTION ] )
+  if ( !active || !check( CACHE_CORRUPTION ) )
   {
     valid[ CACHE_CORRUPTION ] = true;
     _corruption               = player->composite_corruption();
@@ -510,7 +539,7 @@ double player_stat_cache_t::corruption() const
 
 double player_stat_cache_t::corruption_resistance() const
 {
-  if ( !active || !valid[ CACHE_CORRUPTION_RESISTANCE ] )
+  if ( !active || !check( CACHE_CORRUPTION_RESISTANCE ) )
   {
     valid[ CACHE_CORRUPTION_RESISTANCE ] = true;
     _corruption_resistance               = player->composite_corruption_resistance();
@@ -522,10 +551,10 @@ double player_stat_cache_t::corruption_resistance() const
 
 double player_stat_cache_t::player_multiplier( school_e s ) const
 {
-  if ( !active || !player_mult_valid[ s ] )
+  if ( !active || !check( PLAYER_MULT_VALID + s, CACHE_PLAYER_DAMAGE_MULTIPLIER ) )
   {
-    player_mult_valid[ s ] = true;
-    _player_mult[ s ]      = player->composite_player_multiplier( s );
+    valid[ PLAYER_MULT_VALID + s ] = true;
+    _player_mult[ s ]              = player->composite_player_multiplier( s );
   }
   else
     assert( _player_mult[ s ] == player->composite_player_multiplier( s ) );
@@ -536,10 +565,10 @@ double player_stat_cache_t::player_heal_multiplier( const action_state_t* s ) co
 {
   school_e sch = s->action->get_school();
 
-  if ( !active || !player_heal_mult_valid[ sch ] )
+  if ( !active || !check( PLAYER_HEAL_MULT_VALID + sch, CACHE_PLAYER_HEAL_MULTIPLIER ) )
   {
-    player_heal_mult_valid[ sch ] = true;
-    _player_heal_mult[ sch ]      = player->composite_player_heal_multiplier( s );
+    valid[ PLAYER_HEAL_MULT_VALID + sch ] = true;
+    _player_heal_mult[ sch ]              = player->composite_player_heal_multiplier( s );
   }
   else
     assert( _player_heal_mult[ sch ] == player->composite_player_heal_multiplier( s ) );
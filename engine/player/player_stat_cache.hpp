@@ -8,6 +8,9 @@
 #include "config.hpp"
 #include "sc_enums.hpp"
 #include <array>
+#include <bitset>
+#include <cstdint>
+#include <vector>
 
 
 struct action_state_t;
@@ -34,15 +37,50 @@ struct player_t;
  * To create invalidation chains ( eg. Priest: Spirit invalidates Hit ) override the
  * virtual player_t::invalidate_cache( cache_e ) function.
  *
- * Attention: player_t::invalidate_cache( cache_e ) is recursive and may call itself again.
+ * The linked invalidations of player_t::invalidate_cache( cache_e ) ( eg. Strength invalidates
+ * Attack Power ) are compiled into one mask per cache at player_t::init_finished(), so a base
+ * invalidation is a single mask operation on the 'valid'-states. Overrides of
+ * invalidate_cache( cache_e ) are still called for every linked invalidation, and must call the
+ * base implementation first.
  */
 struct player_stat_cache_t
 {
+  // Layout of the 'valid'-states: one bit per cache_e, followed by one bit per school for each of
+  // the school-indexed spell power, damage multiplier and heal multiplier caches.
+  static constexpr unsigned SPELL_POWER_VALID = CACHE_MAX;
+  static constexpr unsigned PLAYER_MULT_VALID = SPELL_POWER_VALID + SCHOOL_MAX + 1;
+  static constexpr unsigned PLAYER_HEAL_MULT_VALID = PLAYER_MULT_VALID + SCHOOL_MAX + 1;
+  static constexpr unsigned VALID_MAX = PLAYER_HEAL_MULT_VALID + SCHOOL_MAX + 1;
+  using mask_t = std::bitset<VALID_MAX>;
+
   const player_t* player;
-  mutable std::array<bool, CACHE_MAX> valid;
-  mutable std::array < bool, SCHOOL_MAX + 1 > spell_power_valid, player_mult_valid, player_heal_mult_valid;
   // 'valid'-states
+  mutable mask_t valid;
+  // Recompute counters per cache: hits are served from the cache, misses recalculate the stat.
+  // Only counted with report_stat_cache=1.
+  mutable std::array<uint64_t, CACHE_MAX> hits, misses;
+  bool count_hits;
+  // Linked invalidation currently passed on to player_t::invalidate_cache( cache_e ) overrides
+  cache_e dispatched;
 private:
+  // 'valid'-states kept by an invalidation of each cache, including linked invalidations
+  std::array<mask_t, CACHE_MAX> keep_mask;
+  // Linked invalidations of each cache, in player_t::invalidate_cache( cache_e ) call order
+  std::array<std::vector<cache_e>, CACHE_MAX> linked_caches;
+
+  bool check( unsigned bit, cache_e c ) const
+  {
+    bool v = valid[ bit ];
+    if ( count_hits )
+    {
+      ++( v ? hits : misses )[ c ];
+    }
+    return v;
+  }
+
+  bool check( cache_e c ) const
+  { return check( c, c ); }
+
   // cached values
   mutable double _strength, _agility, _stamina, _intellect, _spirit;
   mutable double _spell_power[SCHOOL_MAX + 1], _attack_power;
@@ -61,9 +99,15 @@ private:
 public:
   bool active; // runtime active-flag
   void invalidate_all();
-  void invalidate( cache_e );
+  void invalidate( cache_e c )
+  { valid &= keep_mask[ c ]; }
+  const std::vector<cache_e>& linked( cache_e c ) const
+  { return linked_caches[ c ]; }
+  void set_invalidation( cache_e, const mask_t&, std::vector<cache_e> linked );
+  void merge( const player_stat_cache_t& other );
+  static mask_t mask( cache_e );
   double get_attribute( attribute_e ) const;
-  player_stat_cache_t( const player_t* p ) : player( p ), active( false ) { invalidate_all(); }
+  player_stat_cache_t( const player_t* p );
 #if defined(SC_USE_STAT_CACHE)
   // Cache stat functions
   double strength() const;
@@ -1138,6 +1138,7 @@ player_t::player_t( sim_t* s, player_e t, util::string_view n, race_e r )
     current_attack_speed( 1.0 ),
     // Resources
     resources(),
+    resource_version( 0 ),
     // Consumables
     // Events
     executing( nullptr ),
@@ -1293,6 +1294,7 @@ player_t::player_t( sim_t* s, player_e t, util::string_view n, race_e r )
   {
     cache.active = sim->stat_cache != 0;
   }
+  cache.count_hits = sim->report_stat_cache != 0;
   if ( is_pet() )
     current.skill = 1.0;
 
@@ -2065,6 +2067,8 @@ void player_t::init_resources( bool force )
     }
   }
 
+  resource_version++;
+
   // Only collect pet resource timelines if they get reported separately
   if ( !is_pet() || sim->report_pets_separately )
   {
@@ -3010,7 +3014,12 @@ void player_t::init_assessors()
     proc_types pt   = state->proc_type();
     proc_types2 pt2 = state->impact_proc_type2();
     if ( pt != PROC1_INVALID && pt2 != PROC2_INVALID )
-      action_callback_t::trigger( callbacks.procs[ pt ][ pt2 ], state->action, state );
+    {
+      if ( state->action->player == this )
+        state->action->proc_dispatch.trigger( state->action, pt, pt2, state );
+      else
+        action_callback_t::trigger( callbacks.procs[ pt ][ pt2 ], state->action, state );
+    }
 
     return assessor::CONTINUE;
   } );
@@ -3070,6 +3079,8 @@ void player_t::init_finished()
   // Sort outbound assessors
   assessor_out_damage.sort();
 
+  init_stat_cache_invalidations();
+
   // Print items to debug log
   if ( sim->debug )
   {
@@ -4447,94 +4458,159 @@ double player_t::composite_mastery_value() const
 
 #if defined( SC_USE_STAT_CACHE )
 
+namespace
+{
+/**
+ * Collects the caches cleared by an invalidation of a cache, following the linked invalidations of
+ * player_t::invalidate_cache(). Every linked invalidation is also recorded, in call order.
+ *
+ * The stat conversion coefficients are only set up during actor initialization, so the links are
+ * resolved from the initial stats.
+ */
+struct cache_invalidation_collector_t
+{
+  const player_t& p;
+  player_stat_cache_t::mask_t mask;
+  std::vector<cache_e> linked;
+
+  cache_invalidation_collector_t( const player_t& p ) : p( p ), mask(), linked()
+  { }
+
+  void link( cache_e c )
+  {
+    linked.push_back( c );
+    collect( c );
+  }
+
+  void collect( cache_e c )
+  {
+    // Special linked invalidations
+    switch ( c )
+    {
+      case CACHE_STRENGTH:
+        if ( p.initial.attack_power_per_strength > 0 )
+          link( CACHE_ATTACK_POWER );
+        if ( p.initial.parry_per_strength > 0 )
+          link( CACHE_PARRY );
+        break;
+      case CACHE_AGILITY:
+        if ( p.initial.attack_power_per_agility > 0 )
+          link( CACHE_ATTACK_POWER );
+        if ( p.initial.dodge_per_agility > 0 )
+          link( CACHE_DODGE );
+        if ( p.initial.spell_power_per_attack_power > 0 )
+        {
+          link( CACHE_SPELL_POWER );
+          link( CACHE_ATTACK_POWER );
+        }
+        break;
+      case CACHE_INTELLECT:
+        if ( p.initial.spell_power_per_intellect > 0 )
+          link( CACHE_SPELL_POWER );
+        break;
+      case CACHE_ATTACK_HASTE:
+        link( CACHE_ATTACK_SPEED );
+        link( CACHE_RPPM_HASTE );
+        break;
+      case CACHE_SPELL_HASTE:
+        link( CACHE_SPELL_SPEED );
+        link( CACHE_RPPM_HASTE );
+        break;
+      case CACHE_BONUS_ARMOR:
+        link( CACHE_ARMOR );
+        break;
+      case CACHE_ATTACK_CRIT_CHANCE:
+        link( CACHE_RPPM_CRIT );
+        break;
+      case CACHE_SPELL_CRIT_CHANCE:
+        link( CACHE_RPPM_CRIT );
+        break;
+      default:
+        break;
+    }
+
+    // Normal invalidation of the corresponding Cache
+    switch ( c )
+    {
+      case CACHE_EXP:
+        link( CACHE_ATTACK_EXP );
+        link( CACHE_SPELL_HIT );
+        break;
+      case CACHE_HIT:
+        link( CACHE_ATTACK_HIT );
+        link( CACHE_SPELL_HIT );
+        break;
+      case CACHE_CRIT_CHANCE:
+        link( CACHE_ATTACK_CRIT_CHANCE );
+        link( CACHE_SPELL_CRIT_CHANCE );
+        break;
+      case CACHE_HASTE:
+        link( CACHE_ATTACK_HASTE );
+        link( CACHE_SPELL_HASTE );
+        break;
+      case CACHE_VERSATILITY:
+        link( CACHE_DAMAGE_VERSATILITY );
+        link( CACHE_HEAL_VERSATILITY );
+        link( CACHE_MITIGATION_VERSATILITY );
+        break;
+      default:
+        mask |= player_stat_cache_t::mask( c );
+        break;
+    }
+  }
+};
+}  // namespace
+
+/**
+ * Compile the linked invalidations of each cache, so that player_t::invalidate_cache() does not need
+ * to walk them every time a stat changes.
+ */
+void player_t::init_stat_cache_invalidations()
+{
+  for ( cache_e c = CACHE_NONE; c < CACHE_MAX; ++c )
+  {
+    cache_invalidation_collector_t collector( *this );
+    collector.collect( c );
+    cache.set_invalidation( c, collector.mask, std::move( collector.linked ) );
+  }
+}
+
 /**
  * Invalidate a stat cache, resulting in re-calculation of the composite stat value.
+ *
+ * The cache and all of its linked caches are cleared at once. Afterwards each linked cache is still
+ * passed to the (virtual) invalidate_cache, so that actor overrides can react to it; those calls
+ * return here immediately, as their caches have already been cleared.
  */
 void player_t::invalidate_cache( cache_e c )
 {
   if ( !cache.active )
     return;
 
-  sim->print_debug( "{} invalidates stat cache for {}.", *this, c );
-
-  // Special linked invalidations
-  switch ( c )
+  if ( cache.dispatched == c )
   {
-    case CACHE_STRENGTH:
-      if ( current.attack_power_per_strength > 0 )
-        invalidate_cache( CACHE_ATTACK_POWER );
-      if ( current.parry_per_strength > 0 )
-        invalidate_cache( CACHE_PARRY );
-      break;
-    case CACHE_AGILITY:
-      if ( current.attack_power_per_agility > 0 )
-        invalidate_cache( CACHE_ATTACK_POWER );
-      if ( current.dodge_per_agility > 0 )
-        invalidate_cache( CACHE_DODGE );
-      if ( current.spell_power_per_attack_power > 0 )
-      {
-        invalidate_cache( CACHE_SPELL_POWER );
-        invalidate_cache( CACHE_ATTACK_POWER );
-      }
-      break;
-    case CACHE_INTELLECT:
-      if ( current.spell_power_per_intellect > 0 )
-        invalidate_cache( CACHE_SPELL_POWER );
-      break;
-    case CACHE_ATTACK_HASTE:
-      invalidate_cache( CACHE_ATTACK_SPEED );
-      invalidate_cache( CACHE_RPPM_HASTE );
-      break;
-    case CACHE_SPELL_HASTE:
-      invalidate_cache( CACHE_SPELL_SPEED );
-      invalidate_cache( CACHE_RPPM_HASTE );
-      break;
-    case CACHE_BONUS_ARMOR:
-      invalidate_cache( CACHE_ARMOR );
-      break;
-    case CACHE_ATTACK_CRIT_CHANCE:
-      invalidate_cache( CACHE_RPPM_CRIT );
-      break;
-    case CACHE_SPELL_CRIT_CHANCE:
-      invalidate_cache( CACHE_RPPM_CRIT );
-      break;
-    default:
-      break;
+    cache.dispatched = CACHE_MAX;
+    return;
   }
 
-  // Normal invalidation of the corresponding Cache
-  switch ( c )
+  sim->print_debug( "{} invalidates stat cache for {}.", *this, c );
+
+  cache.invalidate( c );
+
+  for ( cache_e linked : cache.linked( c ) )
   {
-    case CACHE_EXP:
-      invalidate_cache( CACHE_ATTACK_EXP );
-      invalidate_cache( CACHE_SPELL_HIT );
-      break;
-    case CACHE_HIT:
-      invalidate_cache( CACHE_ATTACK_HIT );
-      invalidate_cache( CACHE_SPELL_HIT );
-      break;
-    case CACHE_CRIT_CHANCE:
-      invalidate_cache( CACHE_ATTACK_CRIT_CHANCE );
-      invalidate_cache( CACHE_SPELL_CRIT_CHANCE );
-      break;
-    case CACHE_HASTE:
-      invalidate_cache( CACHE_ATTACK_HASTE );
-      invalidate_cache( CACHE_SPELL_HASTE );
-      break;
-    case CACHE_VERSATILITY:
-      invalidate_cache( CACHE_DAMAGE_VERSATILITY );
-      invalidate_cache( CACHE_HEAL_VERSATILITY );
-      invalidate_cache( CACHE_MITIGATION_VERSATILITY );
-      break;
-    default:
-      cache.invalidate( c );
-      break;
+    cache.dispatched = linked;
+    invalidate_cache( linked );
   }
 }
 #else
 void invalidate_cache( cache_e )
 {
 }
+
+void player_t::init_stat_cache_invalidations()
+{
+}
 #endif
 
 void player_t::sequence_add_wait( timespan_t amount, timespan_t ts )
@@ -4844,16 +4920,15 @@ namespace
 {
 namespace buff_merge
 {
-// a < b iff ( a.name < b.name || ( a.name == b.name && a.source < b.source ) )
+// a < b iff ( a.name_id < b.name_id || ( a.name_id == b.name_id && a.source < b.source ) ). Name ids
+// are shared by all threads, see buff_registry_t.
 bool compare( const buff_t* a, const buff_t* b )
 {
   assert( a );
   assert( b );
 
-  if ( a->name_str < b->name_str )
-    return true;
-  if ( b->name_str < a->name_str )
-    return false;
+  if ( a->name_id != b->name_id )
+    return a->name_id < b->name_id;
 
   // NULL and player are identically considered "bottom" for source comparison
   bool a_is_bottom = ( !a->source || a->source == a->player );
@@ -4920,9 +4995,36 @@ void check_tail( player_t& p, size_t first )
 #endif
 }
 
+// a == b under the ordering of compare()
+bool equal( const buff_t* a, const buff_t* b )
+{
+  if ( a->name_id != b->name_id )
+    return false;
+
+  bool a_is_bottom = ( !a->source || a->source == a->player );
+  bool b_is_bottom = ( !b->source || b->source == b->player );
+
+  if ( a_is_bottom || b_is_bottom )
+    return a_is_bottom == b_is_bottom;
+
+  return a->source->index == b->source->index;
+}
+
 // Merge stats of matching buffs from right into left.
 void merge( player_t& left, player_t& right )
 {
+  // Players of different threads create their buffs in the same order, unless buffs were created
+  // on demand (e.g., target data). Pair buffs by index when both lists line up, and only sort and
+  // join them by name id when they do not.
+  left.sim->buff_lookups_merge += left.buff_list.size();
+  if ( left.buff_list.size() == right.buff_list.size() &&
+       std::equal( left.buff_list.begin(), left.buff_list.end(), right.buff_list.begin(), equal ) )
+  {
+    for ( size_t i = 0; i < left.buff_list.size(); ++i )
+      left.buff_list[ i ]->merge( *right.buff_list[ i ] );
+    return;
+  }
+
   prepare( left );
   prepare( right );
 
@@ -4955,6 +5057,19 @@ void merge( player_t& left, player_t& right )
 }
 
 }  // namespace buff_merge
+
+// Find the counterpart of list entry t (at position index) in the other player's list. Players of
+// different threads create their entries in the same order, so check the same position before
+// searching by name.
+template <typename T>
+T* find_merge_entry( const std::vector<T*>& other_list, size_t index, const T& t )
+{
+  if ( index < other_list.size() && other_list[ index ]->name_str == t.name_str )
+    return other_list[ index ];
+
+  auto it = range::find( other_list, t.name_str, &T::name_str );
+  return it != other_list.end() ? *it : nullptr;
+}
 }  // namespace
 
 /**
@@ -4976,11 +5091,22 @@ void player_t::merge( player_t& other )
 
   buff_merge::merge( *this, other );
 
+  cache.merge( other.cache );
+
+  for ( auto* apl : action_priority_list )
+  {
+    if ( auto* other_apl = other.find_action_priority_list( apl->name_str ) )
+    {
+      apl->condition_evaluations += other_apl->condition_evaluations;
+      apl->condition_reuses += other_apl->condition_reuses;
+    }
+  }
+
   // Procs
   for ( size_t i = 0; i < proc_list.size(); ++i )
   {
     proc_t& proc = *proc_list[ i ];
-    if ( proc_t* other_proc = other.find_proc( proc.name_str ) )
+    if ( proc_t* other_proc = find_merge_entry( other.proc_list, i, proc ) )
       proc.merge( *other_proc );
     else
     {
@@ -4994,7 +5120,7 @@ void player_t::merge( player_t& other )
   for ( size_t i = 0; i < gain_list.size(); ++i )
   {
     gain_t& gain = *gain_list[ i ];
-    if ( gain_t* other_gain = other.find_gain( gain.name_str ) )
+    if ( gain_t* other_gain = find_merge_entry( other.gain_list, i, gain ) )
       gain.merge( *other_gain );
     else
     {
@@ -5008,7 +5134,7 @@ void player_t::merge( player_t& other )
   for ( size_t i = 0; i < stats_list.size(); ++i )
   {
     stats_t& stats = *stats_list[ i ];
-    if ( stats_t* other_stats = other.find_stats( stats.name_str ) )
+    if ( stats_t* other_stats = find_merge_entry( other.stats_list, i, stats ) )
       stats.merge( *other_stats );
     else
     {
@@ -5022,7 +5148,7 @@ void player_t::merge( player_t& other )
   for ( size_t i = 0; i < uptime_list.size(); ++i )
   {
     uptime_t& uptime = *uptime_list[ i ];
-    if ( uptime_t* other_uptime = other.find_uptime( uptime.name_str ) )
+    if ( uptime_t* other_uptime = find_merge_entry( other.uptime_list, i, uptime ) )
       uptime.merge( *other_uptime );
     else
     {
@@ -5036,7 +5162,7 @@ void player_t::merge( player_t& other )
   for ( size_t i = 0; i < benefit_list.size(); ++i )
   {
     benefit_t& benefit = *benefit_list[ i ];
-    if ( benefit_t* other_benefit = other.find_benefit( benefit.name_str ) )
+    if ( benefit_t* other_benefit = find_merge_entry( other.benefit_list, i, benefit ) )
       benefit.merge( *other_benefit );
     else
     {
@@ -5050,7 +5176,7 @@ void player_t::merge( player_t& other )
   for ( size_t i = 0; i < sample_data_list.size(); ++i )
   {
     sample_data_helper_t& sd = *sample_data_list[ i ];
-    if ( sample_data_helper_t* other_sd = other.find_sample_data( sd.name_str ) )
+    if ( sample_data_helper_t* other_sd = find_merge_entry( other.sample_data_list, i, sd ) )
       sd.merge( *other_sd );
     else
     {
@@ -5889,6 +6015,8 @@ double player_t::resource_loss( resource_e resource_type, double amount, gain_t*
     iteration_resource_lost[ resource_type ] += actual_amount;
   }
 
+  resource_version++;
+
   if ( source )
   {
     source->add( resource_type, actual_amount * -1, ( amount - actual_amount ) * -1 );
@@ -5924,6 +6052,7 @@ double player_t::resource_gain( resource_e resource_type, double amount, gain_t*
   {
     resources.current[ resource_type ] += actual_amount;
     iteration_resource_gained[ resource_type ] += actual_amount;
+    resource_version++;
   }
   double overflow_amount = amount - actual_amount;
   if (overflow_amount > 0)
@@ -6002,6 +6131,7 @@ void player_t::recalculate_resource_max( resource_e resource_type, gain_t* sourc
     source->add( resource_type, 0, resources.current[ resource_type ] - resources.max[ resource_type ] );
   }
   resources.current[ resource_type ] = std::min( resources.current[ resource_type ], resources.max[ resource_type ] );
+  resource_version++;
 }
 
 role_e player_t::primary_role() const
@@ -8700,10 +8830,12 @@ struct pool_resource_t : public action_t
 
       double theoretical_cost = next_action->cost() + ( amount_expr ? amount_expr->eval() : 0 );
       player->resources.current[ resource ] += theoretical_cost;
+      player->resource_version++;
 
       bool resource_limited = next_action->action_ready();
 
       player->resources.current[ resource ] -= theoretical_cost;
+      player->resource_version++;
 
       if ( !resource_limited )
         return false;
@@ -9955,6 +10087,7 @@ std::unique_ptr<expr_t> player_t::create_expression( util::string_view expressio
           else
           {
             var_ = *it;
+            depends_on( &var_->version_ );
           }
         }
 
@@ -10156,7 +10289,7 @@ std::unique_ptr<expr_t> player_t::create_expression( util::string_view expressio
     {
       // buff.buff_name.buff_property
       get_target_data( this );
-      buff_t* buff = buff_t::find_expressable( buff_list, splits[ 1 ], this );
+      buff_t* buff = buff_t::find_expressable( this, splits[ 1 ], this );
       if ( !buff )
         buff = buff_t::find( this, splits[ 1 ], this );  // Raid debuffs
       if ( buff )
@@ -10396,7 +10529,7 @@ std::unique_ptr<expr_t> player_t::create_resource_expression( util::string_view
     return nullptr;
 
   if ( splits.size() == 1 )
-    return make_ref_expr( name_str, resources.current[ r ] );
+    return expression::depends_on( make_ref_expr( name_str, resources.current[ r ] ), &resource_version );
 
   if ( splits.size() == 2 )
   {
@@ -11768,6 +11901,20 @@ player_collected_data_t::player_collected_data_t( const player_t* player ) :
 
 void player_collected_data_t::reserve_memory( const player_t& p )
 {
+  // Stream the per-iteration player statistics into quantile sketches instead of storing them.
+  // Fight length is kept exact, single actor batch mode needs every value to adjust timelines.
+  if ( p.sim->statistics_sketch > 0 )
+  {
+    for ( auto sd : { &dmg, &compound_dmg, &prioritydps, &dps, &dpse, &dtps, &dmg_taken,
+                      &heal, &compound_heal, &hps, &hpse, &htps, &heal_taken,
+                      &absorb, &compound_absorb, &aps, &atps, &absorb_taken,
+                      &deaths, &theck_meloree_index, &effective_theck_meloree_index, &max_spike_amount,
+                      &target_metric, &waiting_time, &pooling_time, &executed_foreground_actions } )
+    {
+      sd->enable_sketch( p.sim->statistics_sketch );
+    }
+  }
+
   unsigned size = std::min( as<unsigned>( p.sim->iterations ), 2048u );
   fight_length.reserve( size );
   // DMG
@@ -11792,6 +11939,14 @@ void player_collected_data_t::reserve_memory( const player_t& p )
     effective_theck_meloree_index.reserve( size );
     p.sim->num_tanks++;
   }
+
+  // Preallocate timelines for the longest expected fight, so adding to them does not reallocate
+  auto max_time = timespan_t::from_seconds( p.sim->expected_max_time() );
+  timeline_dmg.reserve( max_time );
+  timeline_dmg_taken.reserve( max_time );
+  timeline_healing_taken.reserve( max_time );
+  range::for_each( resource_timelines, [ max_time ]( resource_timeline_t& tl ) { tl.timeline.reserve( max_time ); } );
+  range::for_each( stat_timelines, [ max_time ]( stat_timeline_t& tl ) { tl.timeline.reserve( max_time ); } );
 }
 
 void player_collected_data_t::merge( const player_t& other_player )
@@ -23,6 +23,8 @@
 #include "util/cache.hpp"
 #include "dbc/item_database.hpp"
 #include "assessor.hpp"
+#include "buff/buff_registry.hpp"
+#include "sim/sc_option.hpp"
 #include <map>
 #include <set>
 
@@ -174,6 +176,7 @@ struct player_t : public actor_t
 
   // Option Parsing
   std::vector<std::unique_ptr<option_t>> options;
+  opts::option_index_t option_index;
 
   // Stat Timelines to Display
   std::vector<stat_e> stat_timelines;
@@ -258,6 +261,9 @@ struct player_t : public actor_t
   double current_attack_speed;
 
   player_resources_t resources;
+  /// Bumped on every change to the current resources, see expr_t::depends_on. Code that writes
+  /// resources.current directly, instead of through resource_gain/loss, must bump it as well.
+  uint64_t resource_version;
 
   // Events
   action_t* executing;
@@ -325,6 +331,7 @@ struct player_t : public actor_t
   double tmi_window;
 
   auto_dispose< std::vector<buff_t*> > buff_list;
+  buff_index_t buff_index;
   auto_dispose< std::vector<proc_t*> > proc_list;
   auto_dispose< std::vector<gain_t*> > gain_list;
   auto_dispose< std::vector<stats_t*> > stats_list;
@@ -791,6 +798,7 @@ public:
 
   // Virtual methods
   virtual void invalidate_cache( cache_e c );
+  void init_stat_cache_invalidations();
   virtual void init();
   virtual void override_talent( util::string_view override_str );
   virtual void init_meta_gem();
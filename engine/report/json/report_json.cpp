@@ -187,6 +187,40 @@ void constant_buffs_to_json( JsonOutput root, const player_t& p )
   } );
 }
 
+void stat_cache_to_json( JsonOutput root, const player_t& p )
+{
+  root.make_array();
+  for ( cache_e c = CACHE_NONE; c < CACHE_MAX; ++c )
+  {
+    if ( p.cache.hits[ c ] + p.cache.misses[ c ] == 0 )
+    {
+      continue;
+    }
+
+    auto node = root.add();
+    node[ "cache" ] = util::cache_type_string( c );
+    node[ "hits" ] = p.cache.hits[ c ];
+    node[ "misses" ] = p.cache.misses[ c ];
+  }
+}
+
+void condition_memoization_to_json( JsonOutput root, const player_t& p )
+{
+  root.make_array();
+  for ( const auto* apl : p.action_priority_list )
+  {
+    if ( apl->condition_evaluations + apl->condition_reuses == 0 )
+    {
+      continue;
+    }
+
+    auto node = root.add();
+    node[ "action_list" ] = apl->name_str;
+    node[ "evaluations" ] = apl->condition_evaluations;
+    node[ "reuses" ] = apl->condition_reuses;
+  }
+}
+
 void to_json( JsonOutput root, const stats_t::stats_results_t& sr )
 {
   root[ "actual_amount" ] = sr.actual_amount;
@@ -849,6 +883,16 @@ void to_json( JsonOutput& arr, const ::report::json::report_configuration_t& rep
 
   collected_data_to_json( root[ "collected_data" ], report_configuration, p );
 
+  if ( p.sim -> report_stat_cache != 0 && p.cache.active )
+  {
+    stat_cache_to_json( root[ "stat_cache" ], p );
+  }
+
+  if ( p.sim -> memoize_conditions )
+  {
+    condition_memoization_to_json( root[ "condition_memoization" ], p );
+  }
+
   if ( p.sim -> report_details != 0 )
   {
     buffs_to_json( root[ "buffs" ], p );
@@ -919,6 +963,20 @@ void iteration_data_to_json( JsonOutput root, const std::vector<iteration_data_e
   } );
 }
 
+// Paired difference to the baseline, for profilesets simulated with common random numbers
+void paired_delta_to_json( JsonOutput& root, const profileset::profile_result_t& result, const sim_t& sim )
+{
+  if ( result.paired_iterations() == 0 )
+  {
+    return;
+  }
+
+  root[ "paired_delta" ] = result.paired_delta();
+  root[ "paired_delta_stddev" ] = result.paired_delta_stddev();
+  root[ "paired_delta_error" ] = result.paired_delta_stddev() * sim.confidence_estimator;
+  root[ "paired_iterations" ] = as<uint64_t>( result.paired_iterations() );
+}
+
 void profileset_json2( const profileset::profilesets_t& profileset, const sim_t& sim, js::JsonOutput& root )
 {
 root[ "metric" ] = util::scale_metric_type_string( sim.profileset_metric.front() );
@@ -951,6 +1009,14 @@ root[ "metric" ] = util::scale_metric_type_string( sim.profileset_metric.front()
     }
 
     obj[ "iterations" ] = as<uint64_t>( result.iterations() );
+    paired_delta_to_json( obj, result, sim );
+    obj[ "init_seconds" ] = chrono::to_fp_seconds( profileset -> init_time() );
+    obj[ "simulate_seconds" ] = chrono::to_fp_seconds( profileset -> simulate_time() );
+
+    if ( profileset -> eliminated() )
+    {
+      obj[ "eliminated" ] = true;
+    }
 
     if ( profileset -> results() > 1 )
     {
@@ -974,6 +1040,8 @@ root[ "metric" ] = util::scale_metric_type_string( sim.profileset_metric.front()
           obj2[ "first_quartile" ] = result.first_quartile();
           obj2[ "third_quartile" ] = result.third_quartile();
         }
+
+        paired_delta_to_json( obj2, result, sim );
       }
     }
 
@@ -995,6 +1063,12 @@ void profileset_json3( const profileset::profilesets_t& profilesets, const sim_t
     
     auto&& obj = results.add();
     obj[ "name" ] = profileset -> name();
+    obj[ "init_seconds" ] = chrono::to_fp_seconds( profileset -> init_time() );
+    obj[ "simulate_seconds" ] = chrono::to_fp_seconds( profileset -> simulate_time() );
+    if ( profileset -> eliminated() )
+    {
+      obj[ "eliminated" ] = true;
+    }
     auto results_obj = obj[ "metrics" ].make_array();
     
     for ( size_t midx = 0; midx < sim.profileset_metric.size(); ++midx )
@@ -1020,6 +1094,7 @@ void profileset_json3( const profileset::profilesets_t& profilesets, const sim_t
       }
 
       obj[ "iterations" ] = as<uint64_t>( result.iterations() );
+      paired_delta_to_json( obj, result, sim );
     }
     
     // Optional override ouput data
@@ -1045,9 +1120,9 @@ void profileset_json( const ::report::json::report_configuration_t& report_confi
   
 }
 
-void to_json( const ::report::json::report_configuration_t& report_configuration, JsonOutput root, const sim_t& sim )
+// Sim-scope options and overrides
+void sim_options_to_json( JsonOutput root, const sim_t& sim )
 {
-  // Sim-scope options
   auto options_root = root[ "options" ];
 
   options_root[ "debug" ] = sim.debug;
@@ -1112,6 +1187,7 @@ void to_json( const ::report::json::report_configuration_t& report_configuration
     add_non_zero( scaling_root, "positive_scale_delta", sim.scaling -> positive_scale_delta );
     add_non_zero( scaling_root, "scale_lag", sim.scaling -> scale_lag );
     add_non_zero( scaling_root, "center_scale_delta", sim.scaling -> center_scale_delta );
+    add_non_zero( scaling_root, "scale_work_threads", sim.scaling -> scale_work_threads );
   }
 
   // Overrides
@@ -1134,14 +1210,11 @@ void to_json( const ::report::json::report_configuration_t& report_configuration
   {
     overrides[ "target_health" ] = sim.overrides.target_health;
   }
+}
 
-  // Players
-  JsonOutput players_arr = root[ "players" ].make_array();
-
-  range::for_each( sim.player_no_pet_list.data(), [ & ]( const player_t* p ) {
-    to_json( players_arr, report_configuration, *p );
-  } );
-
+// Profileset results and sim statistics, following the players
+void sim_results_to_json( const ::report::json::report_configuration_t& report_configuration, JsonOutput root, const sim_t& sim )
+{
   if ( sim.profilesets.n_profilesets() > 0 )
   {
     auto profileset_root = root[ "profilesets" ];
@@ -1153,15 +1226,97 @@ void to_json( const ::report::json::report_configuration_t& report_configuration
   stats_root[ "elapsed_time_seconds" ] = chrono::to_fp_seconds(sim.elapsed_time);
   stats_root[ "init_time_seconds" ] = chrono::to_fp_seconds(sim.init_time);
   stats_root[ "merge_time_seconds" ] = chrono::to_fp_seconds(sim.merge_time);
+  stats_root[ "merge_wall_time_seconds" ] = chrono::to_fp_seconds(sim.merge_wall_time);
   stats_root[ "analyze_time_seconds" ] = chrono::to_fp_seconds(sim.analyze_time);
   stats_root[ "simulation_length" ] = sim.simulation_length;
   stats_root[ "total_events_processed" ] = sim.event_mgr.total_events_processed;
+  auto buff_lookups_root = stats_root[ "buff_lookups" ];
+  buff_lookups_root[ "init" ] = sim.buff_lookups_init;
+  buff_lookups_root[ "simulation" ] = sim.buff_lookups_simulation;
+  buff_lookups_root[ "merge" ] = sim.buff_lookups_merge;
+  if ( sim.scaling -> num_scaling_stats > 0 )
+  {
+    auto scale_root = stats_root[ "scale_factor_time_seconds" ];
+    for ( stat_e i = STAT_NONE; i < STAT_MAX; i++ )
+    {
+      if ( sim.scaling -> stat_time[ i ] != chrono::wall_clock::duration::zero() )
+      {
+        scale_root[ util::stat_type_abbrev( i ) ] = chrono::to_fp_seconds( sim.scaling -> stat_time[ i ] );
+      }
+    }
+  }
+  {
+    auto size_classes = stats_root[ "event_size_classes" ].make_array();
+    for ( size_t i = 0; i < sim.event_mgr.size_classes.size(); ++i )
+    {
+      const auto& size_class = sim.event_mgr.size_classes[ i ];
+      if ( size_class.allocated_events == 0 )
+      {
+        continue;
+      }
+
+      auto entry = size_classes.add();
+      entry[ "size" ] = as<unsigned>( ( i + 1 ) * event_t::ALLOC_GRANULARITY );
+      entry[ "allocated_events" ] = size_class.allocated_events;
+      entry[ "peak_live_events" ] = size_class.peak_live_events;
+    }
+  }
   add_non_zero( stats_root, "raid_dps", sim.raid_dps );
   add_non_zero( stats_root, "raid_hps", sim.raid_hps );
   add_non_zero( stats_root, "raid_aps", sim.raid_aps );
   add_non_zero( stats_root, "total_dmg", sim.total_dmg );
   add_non_zero( stats_root, "total_heal", sim.total_heal );
   add_non_zero( stats_root, "total_absorb", sim.total_absorb );
+}
+
+// Raid events, sim auras and iteration data, following the targets of a detailed report
+void sim_details_to_json( JsonOutput root, const sim_t& sim )
+{
+  // Raid events
+  if ( ! sim.raid_events.empty() )
+  {
+    auto arr = root[ "raid_events" ].make_array();
+
+    range::for_each( sim.raid_events, [ & ]( const std::unique_ptr<raid_event_t>& event ) {
+      to_json( arr, *event );
+    } );
+  }
+
+  if ( sim.buff_list.size() > 0 )
+  {
+    JsonOutput buffs_arr = root[ "sim_auras" ].make_array();
+    range::for_each( sim.buff_list, [ & ]( const buff_t* b ) {
+      if ( b -> avg_start.mean() == 0 )
+      {
+        return;
+      }
+      to_json( buffs_arr.add(), b );
+    } );
+  }
+
+  if ( sim.low_iteration_data.size() > 0 )
+  {
+    iteration_data_to_json( root[ "iteration_data" ][ "low" ], sim.low_iteration_data );
+  }
+
+  if ( sim.high_iteration_data.size() > 0 )
+  {
+    iteration_data_to_json( root[ "iteration_data" ][ "high" ], sim.high_iteration_data );
+  }
+}
+
+void to_json( const ::report::json::report_configuration_t& report_configuration, JsonOutput root, const sim_t& sim )
+{
+  sim_options_to_json( root, sim );
+
+  // Players
+  JsonOutput players_arr = root[ "players" ].make_array();
+
+  range::for_each( sim.player_no_pet_list.data(), [ & ]( const player_t* p ) {
+    to_json( players_arr, report_configuration, *p );
+  } );
+
+  sim_results_to_json( report_configuration, root, sim );
 
   if ( sim.report_details != 0 )
   {
@@ -1172,69 +1327,131 @@ void to_json( const ::report::json::report_configuration_t& report_configuration
       to_json( targets_arr, report_configuration, *p );
     } );
 
-    // Raid events
-    if ( ! sim.raid_events.empty() )
-    {
-      auto arr = root[ "raid_events" ].make_array();
+    sim_details_to_json( root, sim );
+  }
+}
 
-      range::for_each( sim.raid_events, [ & ]( const std::unique_ptr<raid_event_t>& event ) {
-        to_json( arr, *event );
-      } );
-    }
+// Report header, preceding the sim
+void header_to_json( const ::report::json::report_configuration_t& report_configuration, JsonOutput root )
+{
+  if (report_configuration.version_intersects(">=3.0.0"))
+  {
+    root["$id"] = fmt::format("https://www.simulationcraft.org/reports/{}.schema.json", report_configuration.version());
+  }
+  root[ "version" ] = SC_VERSION;
+  root[ "report_version" ] = report_configuration.version();
+  root[ "ptr_enabled" ] = SC_USE_PTR;
+  root[ "beta_enabled" ] = SC_BETA;
+  root[ "build_date" ] = __DATE__;
+  root[ "build_time" ] = __TIME__;
+  root[ "timestamp" ] = as<uint64_t>( std::time( nullptr ) );
+#if defined( SC_NO_NETWORKING )
+  root[ "no_networking" ] = true;
+#endif
 
-    if ( sim.buff_list.size() > 0 )
-    {
-      JsonOutput buffs_arr = root[ "sim_auras" ].make_array();
-      range::for_each( sim.buff_list, [ & ]( const buff_t* b ) {
-        if ( b -> avg_start.mean() == 0 )
-        {
-          return;
-        }
-        to_json( buffs_arr.add(), b );
-      } );
-    }
+  if ( git_info::available())
+  {
+    root[ "git_revision" ] = git_info::revision();
+    root[ "git_branch" ] = git_info::branch();
+  }
+}
 
-    if ( sim.low_iteration_data.size() > 0 )
-    {
-      iteration_data_to_json( root[ "iteration_data" ][ "low" ], sim.low_iteration_data );
-    }
+// Notifications, following the sim
+void notifications_to_json( JsonOutput root, const sim_t& sim )
+{
+  if ( sim.error_list.size() > 0 )
+  {
+    root[ "notifications" ] = sim.error_list;
+  }
+}
 
-    if ( sim.high_iteration_data.size() > 0 )
-    {
-      iteration_data_to_json( root[ "iteration_data" ][ "high" ], sim.high_iteration_data );
-    }
+template <typename Handler>
+void write_value( Handler& writer, const Value& value )
+{
+  if ( !value.Accept( writer ) )
+  {
+    throw std::runtime_error("JSON Writer did not accept document.");
   }
 }
 
-void normal_print(FileWriteStream& stream, Document& doc, const ::report::json::report_configuration_t& report_configuration  )
+// Build object members into a temporary document, and write them to the object currently open in the writer
+template <typename Handler, typename Fn>
+void write_members( Handler& writer, Fn&& fn )
 {
-  Writer<FileWriteStream> writer( stream );
-  if (report_configuration.decimal_places > 0)
+  Document doc;
+  doc.SetObject();
+  fn( JsonOutput( doc, doc ) );
+
+  for ( auto it = doc.MemberBegin(); it != doc.MemberEnd(); ++it )
   {
-    writer.SetMaxDecimalPlaces(report_configuration.decimal_places);
+    writer.Key( it -> name.GetString(), it -> name.GetStringLength() );
+    write_value( writer, it -> value );
   }
-  auto accepted = doc.Accept( writer );
-  if ( !accepted )
+}
+
+// Build array elements into a temporary document, and write them to the array currently open in the writer
+template <typename Handler, typename Fn>
+void write_elements( Handler& writer, Fn&& fn )
+{
+  Document doc;
+  doc.SetArray();
+  JsonOutput arr( doc, doc );
+  fn( arr );
+
+  for ( auto it = doc.Begin(); it != doc.End(); ++it )
   {
-    throw std::runtime_error("JSON Writer did not accept document.");
+    write_value( writer, *it );
   }
 }
 
-void pretty_print(FileWriteStream& stream, Document& doc, const ::report::json::report_configuration_t& report_configuration  )
+// Write the report while walking the sim. Only the report skeleton is written through the SAX interface, its
+// parts are built into small documents of their own and written out right away, so at most one actor is held in
+// memory at a time. The output is identical to writing the document built by print_json_document().
+template <typename Handler>
+void stream_json( Handler& writer, const sim_t& sim, const ::report::json::report_configuration_t& report_configuration )
 {
-  PrettyWriter<FileWriteStream> writer( stream );
-  if (report_configuration.decimal_places > 0)
+  writer.StartObject();
+
+  write_members( writer, [ & ]( JsonOutput root ) { header_to_json( report_configuration, root ); } );
+
+  writer.Key( "sim" );
+  writer.StartObject();
+
+  write_members( writer, [ & ]( JsonOutput root ) { sim_options_to_json( root, sim ); } );
+
+  writer.Key( "players" );
+  writer.StartArray();
+  for ( const player_t* p : sim.player_no_pet_list )
   {
-    writer.SetMaxDecimalPlaces(report_configuration.decimal_places);
+    write_elements( writer, [ & ]( JsonOutput& arr ) { to_json( arr, report_configuration, *p ); } );
   }
-  auto accepted = doc.Accept( writer );
-  if ( !accepted )
+  writer.EndArray();
+
+  write_members( writer, [ & ]( JsonOutput root ) { sim_results_to_json( report_configuration, root, sim ); } );
+
+  if ( sim.report_details != 0 )
   {
-    throw std::runtime_error("JSON Writer did not accept document.");
+    writer.Key( "targets" );
+    writer.StartArray();
+    for ( const player_t* p : sim.target_list )
+    {
+      write_elements( writer, [ & ]( JsonOutput& arr ) { to_json( arr, report_configuration, *p ); } );
+    }
+    writer.EndArray();
+
+    write_members( writer, [ & ]( JsonOutput root ) { sim_details_to_json( root, sim ); } );
   }
+
+  writer.EndObject();
+
+  write_members( writer, [ & ]( JsonOutput root ) { notifications_to_json( root, sim ); } );
+
+  writer.EndObject();
 }
 
-void print_json_pretty( FILE* o, const sim_t& sim, const ::report::json::report_configuration_t& report_configuration )
+// Write the report by building the whole document first ( report option streaming=0 )
+template <typename Handler>
+void print_json_document( Handler& writer, const sim_t& sim, const ::report::json::report_configuration_t& report_configuration )
 {
   Document doc;
   Value& v = doc;
@@ -1242,45 +1459,45 @@ void print_json_pretty( FILE* o, const sim_t& sim, const ::report::json::report_
 
   JsonOutput root( doc, v );
 
-  if (report_configuration.version_intersects(">=3.0.0"))
+  header_to_json( report_configuration, root );
+  to_json( report_configuration, root[ "sim" ], sim );
+  notifications_to_json( root, sim );
+
+  write_value( writer, doc );
+}
+
+template <typename Handler>
+void write_report( Handler& writer, const sim_t& sim, const ::report::json::report_configuration_t& report_configuration )
+{
+  if (report_configuration.decimal_places > 0)
   {
-    root["$id"] = fmt::format("https://www.simulationcraft.org/reports/{}.schema.json", report_configuration.version());
+    writer.SetMaxDecimalPlaces(report_configuration.decimal_places);
   }
-  root[ "version" ] = SC_VERSION;
-  root[ "report_version" ] = report_configuration.version();
-  root[ "ptr_enabled" ] = SC_USE_PTR;
-  root[ "beta_enabled" ] = SC_BETA;
-  root[ "build_date" ] = __DATE__;
-  root[ "build_time" ] = __TIME__;
-  root[ "timestamp" ] = as<uint64_t>( std::time( nullptr ) );
-#if defined( SC_NO_NETWORKING )
-  root[ "no_networking" ] = true;
-#endif
 
-  if ( git_info::available())
+  if ( report_configuration.streaming )
   {
-    root[ "git_revision" ] = git_info::revision();
-    root[ "git_branch" ] = git_info::branch();
+    stream_json( writer, sim, report_configuration );
   }
-
-  to_json( report_configuration, root[ "sim" ], sim );
-
-  if ( sim.error_list.size() > 0 )
+  else
   {
-    root[ "notifications" ] = sim.error_list;
+    print_json_document( writer, sim, report_configuration );
   }
+}
 
+void print_json_pretty( FILE* o, const sim_t& sim, const ::report::json::report_configuration_t& report_configuration )
+{
   std::array<char, 16384> buffer;
   FileWriteStream b( o, buffer.data(), buffer.size() );
   if (report_configuration.pretty_print)
   {
-    pretty_print(b, doc, report_configuration);
+    PrettyWriter<FileWriteStream> writer( b );
+    write_report( writer, sim, report_configuration );
   }
   else
   {
-    normal_print(b, doc, report_configuration);
+    Writer<FileWriteStream> writer( b );
+    write_report( writer, sim, report_configuration );
   }
-  
 }
 
 void print_json_report( sim_t& sim, const ::report::json::report_configuration_t& report_configuration)
@@ -1328,4 +1545,12 @@ namespace report
     }
   }
 
+  // Write a compact, current version JSON report of the sim to an already open stream.
+  void print_json( sim_t& sim, FILE* out )
+  {
+    auto report_configuration = ::report::json::create_report_entry( sim, "", "" );
+    report_configuration.pretty_print = false;
+    print_json_pretty( out, sim, report_configuration );
+  }
+
 }  // report
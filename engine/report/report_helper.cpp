@@ -667,16 +667,18 @@ void report_helper::print_html_sample_data( report::sc_html_stream& os, const pl
       data.mean() ? ( ( data.max() - data.min() ) / 2 ) * 100 / data.mean() : 0 );
   if ( !data.simple )
   {
+    // Percentiles estimated from a quantile sketch are marked as approximate
+    const char* approx = data.approximate() ? " (approx.)" : "";
     os.printf( "<tr>\n<td class=\"left\">Standard Deviation</td>\n<td class=\"right\">%.4f</td>\n</tr>\n",
                data.std_dev );
-    os.printf( "<tr>\n<td class=\"left\">5th Percentile</td>\n<td class=\"right\">%.2f</td>\n</tr>\n",
-               data.percentile( 0.05 ) );
-    os.printf( "<tr>\n<td class=\"left\">95th Percentile</td>\n<td class=\"right\">%.2f</td>\n</tr>\n",
-               data.percentile( 0.95 ) );
+    os.printf( "<tr>\n<td class=\"left\">5th Percentile%s</td>\n<td class=\"right\">%.2f</td>\n</tr>\n",
+               approx, data.percentile( 0.05 ) );
+    os.printf( "<tr>\n<td class=\"left\">95th Percentile%s</td>\n<td class=\"right\">%.2f</td>\n</tr>\n",
+               approx, data.percentile( 0.95 ) );
     os.printf(
-        "<tr>\n<td class=\"left\">( 95th Percentile - 5th Percentile )</td>\n"
+        "<tr>\n<td class=\"left\">( 95th Percentile - 5th Percentile )%s</td>\n"
         "<td class=\"right\">%.2f</td>\n</tr>\n",
-        data.percentile( 0.95 ) - data.percentile( 0.05 ) );
+        approx, data.percentile( 0.95 ) - data.percentile( 0.05 ) );
 
     os << "<tr>\n"
        << "<th class=\"left\" colspan=\"2\">Mean Distribution</th>\n"
@@ -31,6 +31,25 @@ void print_profiles( sim_t* );
 void print_text( sim_t*, bool detail );
 void print_html( sim_t& );
 void print_json( sim_t& );
+void print_json( sim_t&, FILE* );
 void print_html_player( report::sc_html_stream&, player_t& );
+
+// The actor section of the HTML report, split into segments that can be rendered separately. Live
+// segments read the current state of the actor ( composite stats, class module sections ), which updates
+// caches and buff state shared with other actors, and are rendered by one thread at a time. The other
+// segments only read collected data, and can be rendered for different actors concurrently once
+// prepare_html_player() ran for each of them.
+enum html_player_segment_e
+{
+  HTML_PLAYER_SUMMARY,
+  HTML_PLAYER_CUSTOM,
+  HTML_PLAYER_DETAILS,
+  HTML_PLAYER_STATS,
+  HTML_PLAYER_PROFILE,
+  HTML_PLAYER_SEGMENT_MAX
+};
+bool html_player_segment_live( html_player_segment_e );
+void prepare_html_player( player_t& );
+void print_html_player_segment( report::sc_html_stream&, player_t&, html_player_segment_e );
 void print_suite( sim_t* );
 }  // namespace report
\ No newline at end of file
@@ -4712,46 +4712,62 @@ void print_html_player_deaths( report::sc_html_stream& os, const player_t& p,
   }
 }
 
-// print_html_player_ =======================================================
+// print_html_player_segment_ ===============================================
 
-void print_html_player_( report::sc_html_stream& os, const player_t& p )
+void print_html_player_segment_( report::sc_html_stream& os, player_t& p, report::html_player_segment_e segment )
 {
-  print_html_player_description( os, p );
+  switch ( segment )
+  {
+    case report::HTML_PLAYER_SUMMARY:
+      print_html_player_description( os, p );
 
-  print_html_player_results_spec_gear( os, p );
+      print_html_player_results_spec_gear( os, p );
 
-  print_html_player_scale_factors( os, p, p.report_information );
+      print_html_player_scale_factors( os, p, p.report_information );
 
-  print_html_player_charts( os, p, p.report_information );
+      print_html_player_charts( os, p, p.report_information );
 
-  print_html_player_abilities( os, p );
+      print_html_player_abilities( os, p );
 
-  print_html_player_buffs( os, p, p.report_information );
+      print_html_player_buffs( os, p, p.report_information );
 
-  print_html_player_procs( os, p );
+      print_html_player_procs( os, p );
+      break;
 
-  print_html_player_custom_section( os, p, p.report_information );
+    case report::HTML_PLAYER_CUSTOM:
+      print_html_player_custom_section( os, p, p.report_information );
+      break;
 
-  print_html_player_resources( os, p );
+    case report::HTML_PLAYER_DETAILS:
+      print_html_player_resources( os, p );
 
-  print_html_player_deaths( os, p, p.report_information );
+      print_html_player_deaths( os, p, p.report_information );
 
-  print_html_player_statistics( os, p, p.report_information );
+      print_html_player_statistics( os, p, p.report_information );
 
-  print_html_player_action_priority_list( os, p );
+      print_html_player_action_priority_list( os, p );
+      break;
 
-  print_html_stats( os, p );
+    case report::HTML_PLAYER_STATS:
+      print_html_stats( os, p );
+      break;
 
-  print_html_gear( os, p );
+    case report::HTML_PLAYER_PROFILE:
+      print_html_gear( os, p );
 
-  print_html_talents( os, p );
+      print_html_talents( os, p );
 
-  print_html_profile( os, p, p.report_information );
+      print_html_profile( os, p, p.report_information );
 
-  // print_html_player_gear_weights( os, p, p.report_information );
+      // print_html_player_gear_weights( os, p, p.report_information );
 
-  os << "</div>\n"
-     << "</div>\n\n";
+      os << "</div>\n"
+         << "</div>\n\n";
+      break;
+
+    default:
+      break;
+  }
 }
 
 void build_action_markers( player_t& p )
@@ -4794,10 +4810,28 @@ void build_player_report_data( player_t& p )
 
 namespace report
 {
-void print_html_player( report::sc_html_stream& os, player_t& p )
+bool html_player_segment_live( html_player_segment_e segment )
+{
+  return segment == HTML_PLAYER_CUSTOM || segment == HTML_PLAYER_STATS;
+}
+
+void prepare_html_player( player_t& p )
 {
   build_player_report_data( p );
-  print_html_player_( os, p );
+}
+
+void print_html_player_segment( report::sc_html_stream& os, player_t& p, html_player_segment_e segment )
+{
+  print_html_player_segment_( os, p, segment );
+}
+
+void print_html_player( report::sc_html_stream& os, player_t& p )
+{
+  prepare_html_player( p );
+  for ( int segment = 0; segment < HTML_PLAYER_SEGMENT_MAX; ++segment )
+  {
+    print_html_player_segment_( os, p, static_cast<html_player_segment_e>( segment ) );
+  }
 }
 
 }  // END report NAMESPACE
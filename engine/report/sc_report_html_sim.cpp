@@ -13,7 +13,12 @@
 #include "sim/scale_factor_control.hpp"
 #include "fmt/chrono.h"
 
+#include <array>
+#include <atomic>
+#include <exception>
+#include <functional>
 #include <iostream>
+#include <sstream>
 
 namespace
 {  // UNNAMED NAMESPACE ==========================================
@@ -449,6 +454,12 @@ void print_html_sim_summary( report::sc_html_stream& os, sim_t& sim )
              "</tr>\n",
              chrono::to_fp_seconds(sim.elapsed_time) );
 
+  os.printf( "<tr class=\"left\">\n"
+             "<th>Report Render Seconds:</th>\n"
+             "<td>%.4f</td>\n"
+             "</tr>\n",
+             chrono::to_fp_seconds(sim.html_render_time) );
+
   os.printf( "<tr class=\"left\">\n"
              "<th>Speed Up:</th>\n"
              "<td>%.0f</td>\n"
@@ -1310,6 +1321,125 @@ void print_nothing_to_report( report::sc_html_stream& os, const std::string& rea
 
 /* Main function building the html document and calling subfunctions
  */
+// Actor section of the report, rendered ahead of writing the report
+struct html_part_t
+{
+  // Segment of the section, see report::html_player_segment_e
+  struct segment_t
+  {
+    std::stringbuf html;
+    sim_t::report_chart_data_t chart_data;
+  };
+
+  player_t* player;
+  std::array<segment_t, report::HTML_PLAYER_SEGMENT_MAX> segments;
+  std::exception_ptr error;
+
+  html_part_t( player_t* player ) : player( player )
+  { }
+};
+
+class html_render_thread_t : public sc_thread_t
+{
+  std::function<void()> work;
+
+  void run() override
+  { work(); }
+
+public:
+  html_render_thread_t( std::function<void()> work ) : work( std::move( work ) )
+  { }
+};
+
+// Render the live ( live == true ) or the other segments of an actor section
+void render_html_part( const report::sc_html_stream& format, html_part_t& part, bool live )
+{
+  if ( part.error )
+  {
+    return;
+  }
+
+  try
+  {
+    if ( live )
+    {
+      report::prepare_html_player( *part.player );
+    }
+
+    for ( int i = 0; i < report::HTML_PLAYER_SEGMENT_MAX; ++i )
+    {
+      auto segment = static_cast<report::html_player_segment_e>( i );
+      if ( report::html_player_segment_live( segment ) != live )
+      {
+        continue;
+      }
+
+      report::sc_html_stream os;
+      os.copyfmt( format );
+      os.std::ios::rdbuf( &part.segments[ i ].html );
+
+      sim_t::report_chart_scope_t scope( part.segments[ i ].chart_data );
+      report::print_html_player_segment( os, *part.player, segment );
+    }
+  }
+  catch ( ... )
+  {
+    part.error = std::current_exception();
+  }
+}
+
+// Render the actor sections of the report. Live segments read and update actor state that may be
+// shared between actors ( caches, buffs ), so they are rendered serially first. The other segments
+// are then rendered on up to sim.threads threads. Each segment collects its html and chart data
+// separately, and is written in report order by write_html_part(), so the report is identical to
+// one rendered serially.
+void render_html_parts( const report::sc_html_stream& format, sim_t& sim, std::vector<std::unique_ptr<html_part_t>>& parts )
+{
+  const auto start_time = chrono::wall_clock::now();
+
+  for ( auto& part : parts )
+  {
+    render_html_part( format, *part, true );
+  }
+
+  std::atomic<size_t> next_part( 0 );
+  auto work = [ & ]() {
+    for ( size_t i = next_part++; i < parts.size(); i = next_part++ )
+    {
+      render_html_part( format, *parts[ i ], false );
+    }
+  };
+
+  const size_t n_threads = std::min( as<size_t>( std::max( 1, sim.threads ) ), parts.size() );
+  std::vector<std::unique_ptr<html_render_thread_t>> threads;
+  for ( size_t i = 1; i < n_threads; ++i )
+  {
+    threads.push_back( std::make_unique<html_render_thread_t>( work ) );
+    threads.back()->launch();
+  }
+
+  work();
+
+  range::for_each( threads, []( std::unique_ptr<html_render_thread_t>& thread ) { thread->join(); } );
+
+  sim.html_render_time = chrono::elapsed( start_time );
+}
+
+void write_html_part( report::sc_html_stream& os, sim_t& sim, html_part_t& part )
+{
+  if ( part.error )
+  {
+    std::rethrow_exception( part.error );
+  }
+
+  for ( auto& segment : part.segments )
+  {
+    const std::string html = segment.html.str();
+    os.write( html.data(), html.size() );
+    sim.add_chart_data( segment.chart_data );
+  }
+}
+
 void print_html_( report::sc_html_stream& os, sim_t& sim )
 {
   // Set floating point formatting
@@ -1361,10 +1491,12 @@ void print_html_( report::sc_html_stream& os, sim_t& sim )
 
   sim.profilesets.output_html( sim, os );
 
-  // Report Players
+  // Players and targets are rendered concurrently, then written in order
+  std::vector<std::unique_ptr<html_part_t>> parts;
+
   for ( auto& player : sim.players_by_name )
   {
-    report::print_html_player( os, *player );
+    parts.push_back( std::make_unique<html_part_t>( player ) );
 
     // Pets
     if ( sim.report_pets_separately )
@@ -1372,22 +1504,18 @@ void print_html_( report::sc_html_stream& os, sim_t& sim )
       for ( auto& pet : player->pet_list )
       {
         if ( pet->summoned && !pet->quiet )
-          report::print_html_player( os, *pet );
+          parts.push_back( std::make_unique<html_part_t>( pet ) );
       }
     }
   }
 
-  print_html_sim_summary( os, sim );
+  const size_t n_player_parts = parts.size();
 
-  if ( sim.report_raw_abilities )
-    raw_ability_summary::print( os, sim );
-
-  // Report Targets
   if ( sim.report_targets )
   {
     for ( auto& player : sim.targets_by_name )
     {
-      report::print_html_player( os, *player );
+      parts.push_back( std::make_unique<html_part_t>( player ) );
 
       // Pets
       if ( sim.report_pets_separately )
@@ -1395,12 +1523,31 @@ void print_html_( report::sc_html_stream& os, sim_t& sim )
         for ( auto& pet : player->pet_list )
         {
           // if ( pet -> summoned )
-          report::print_html_player( os, *pet );
+          parts.push_back( std::make_unique<html_part_t>( pet ) );
         }
       }
     }
   }
 
+  render_html_parts( os, sim, parts );
+
+  // Report Players
+  for ( size_t i = 0; i < n_player_parts; ++i )
+  {
+    write_html_part( os, sim, *parts[ i ] );
+  }
+
+  print_html_sim_summary( os, sim );
+
+  if ( sim.report_raw_abilities )
+    raw_ability_summary::print( os, sim );
+
+  // Report Targets
+  for ( size_t i = n_player_parts; i < parts.size(); ++i )
+  {
+    write_html_part( os, sim, *parts[ i ] );
+  }
+
   print_html_help_boxes( os, sim );
 
   // jQuery
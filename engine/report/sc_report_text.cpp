@@ -731,10 +731,28 @@ void sim_summary_performance( std::ostream& os, sim_t* sim )
 {
   std::time_t cur_time = std::time( nullptr );
 
-  std::string iterations_str;
+  std::string iterations_str, idle_str, merge_str;
   if ( sim -> threads > 1 )
+  {
+    auto merge_wall = chrono::to_fp_seconds( sim -> merge_wall_time );
+    if ( merge_wall > 0 )
+    {
+      merge_str = fmt::format( " (wall {:.3f}, speedup {:.2f})", merge_wall,
+          chrono::to_fp_seconds( sim -> merge_time ) / merge_wall );
+    }
+
     iterations_str = fmt::format( " ({})", fmt::join( sim -> work_per_thread, ", " ) );
 
+    std::vector<double> idle_seconds;
+    for ( const auto& idle : sim -> idle_per_thread )
+    {
+      idle_seconds.push_back( chrono::to_fp_seconds( idle ) );
+    }
+    idle_str = fmt::format( "  IdleSeconds   = {:.3f} ({:.3f})\n",
+        std::accumulate( idle_seconds.begin(), idle_seconds.end(), 0.0 ),
+        fmt::join( idle_seconds, ", " ) );
+  }
+
   fmt::print(
       os,
       "\n\nBaseline Performance:\n"
@@ -743,41 +761,42 @@ void sim_summary_performance( std::ostream& os, sim_t* sim )
 #endif
       "  RNG Engine    = {}{}\n"
       "  Iterations    = {}{}\n"
+      "{}"
       "  TotalEvents   = {}\n"
       "  MaxEventQueue = {}\n"
+      "  BuffLookups   = {} init, {} simulation, {} merge\n"
 #ifdef EVENT_QUEUE_DEBUG
       "  AllocEvents   = {}\n"
-      "  EndInsert     = {} ({:.3f}%)\n"
-      "  MaxTravDepth  = {}\n"
-      "  AvgTravDepth  = {}\n"
+      "  Cascaded      = {} ({:.3f}%)\n"
+      "  MaxSlotDepth  = {}\n"
 #endif
       "  TargetHealth  = {:.0f}\n"
       "  SimSeconds    = {:.3f}\n"
       "  CpuSeconds    = {}\n"
       "  WallSeconds   = {}\n"
       "  InitSeconds   = {}\n"
-      "  MergeSeconds  = {}\n"
+      "  MergeSeconds  = {}{}\n"
       "  AnalyzeSeconds= {}\n"
       "  SpeedUp       = {:.0f}\n"
       "  EndTime       = {:%Y-%m-%d %H:%M:%S%z} ({})\n\n",
       sim->rng().name(), sim->deterministic ? " (deterministic)" : "",
       sim->iterations,
       sim -> threads > 1 ? iterations_str : "",
+      idle_str,
       sim->event_mgr.total_events_processed,
       sim->event_mgr.max_events_remaining,
+      sim->buff_lookups_init, sim->buff_lookups_simulation, sim->buff_lookups_merge,
 #ifdef EVENT_QUEUE_DEBUG
-      sim->event_mgr.n_allocated_events, sim->event_mgr.n_end_insert,
-      100.0 * static_cast<double>( sim->event_mgr.n_end_insert ) /
+      sim->event_mgr.n_allocated_events, sim->event_mgr.events_cascaded,
+      100.0 * static_cast<double>( sim->event_mgr.events_cascaded ) /
           sim->event_mgr.events_added,
       sim->event_mgr.max_queue_depth,
-      static_cast<double>( sim->event_mgr.events_traversed ) /
-          sim->event_mgr.events_added,
 #endif
       sim->target->resources.base[ RESOURCE_HEALTH ],
       sim->simulation_length.sum(), chrono::to_fp_seconds(sim->elapsed_cpu),
       chrono::to_fp_seconds(sim->elapsed_time),
       chrono::to_fp_seconds(sim->init_time),
-      chrono::to_fp_seconds(sim->merge_time),
+      chrono::to_fp_seconds(sim->merge_time), merge_str,
       chrono::to_fp_seconds(sim->analyze_time),
       sim->iterations * sim->simulation_length.mean() / chrono::to_fp_seconds(sim->elapsed_cpu),
       fmt::localtime(cur_time), cur_time );
@@ -786,26 +805,31 @@ void sim_summary_performance( std::ostream& os, sim_t* sim )
 
   for ( unsigned i = 0; i < sim->event_mgr.event_queue_depth_samples.size(); ++i )
   {
-    auto& sample = sim->event_mgr.event_queue_depth_samples[ i ];
-    if ( sample.first == 0 )
+    auto sample = sim->event_mgr.event_queue_depth_samples[ i ];
+    if ( sample == 0 )
     {
       continue;
     }
 
-    double p = 100.0 * static_cast<double>( sample.first ) / sim->event_mgr.events_added;
-    double p2 = 100.0 * static_cast<double>( sample.second ) / sample.first;
+    double p = 100.0 * static_cast<double>( sample ) / sim->event_mgr.events_added;
     total_p += p;
-    fmt::print( os, "Depth: {:4} Samples: {:9} ({:6.3f}% / {:7.3f}%) tail-inserts: {:9} ({:7.3f}%)\n",
-        i,
-        sample.first, p, total_p,
-        sample.second, p2 );
-
-
+    fmt::print( os, "Depth: {:4} Samples: {:9} ({:6.3f}% / {:7.3f}%)\n",
+        i, sample, p, total_p );
   }
   fmt::print( os, "Total: {:.3f}% Samples: {}\n",
       total_p,
       sim->event_mgr.events_added );
 
+  fmt::print( os, "\nEvent Queue Wheel Levels:\n" );
+  for ( size_t i = 0; i < sim->event_mgr.event_queue_level_samples.size(); ++i )
+  {
+    auto sample = sim->event_mgr.event_queue_level_samples[ i ];
+    fmt::print( os, "Level: {:4} Samples: {:9} ({:6.3f}%)\n",
+        i < event_manager_t::WHEEL_LEVELS ? fmt::format( "{}", i ) : std::string( "far" ),
+        sample,
+        100.0 * static_cast<double>( sample ) / sim->event_mgr.events_added );
+  }
+
   fmt::print( os, "\nEvent Queue Allocation:\n" );
   double total_a = 0;
   for ( size_t i = 0; i < sim->event_mgr.event_requested_size_count.size();
@@ -829,8 +853,19 @@ void sim_summary_performance( std::ostream& os, sim_t* sim )
   fmt::print( os, "Total: {:.3f}% Alloc Samples: {}\n",
       total_p,
       sim->event_mgr.n_requested_events );
-  fmt::print( os, "Alloc size used for event_t: {}\n",
-      util::next_power_of_two( 2 * sizeof( event_t ) ) );
+  for ( size_t i = 0; i < sim->event_mgr.size_classes.size(); ++i )
+  {
+    const auto& size_class = sim->event_mgr.size_classes[ i ];
+    if ( size_class.allocated_events == 0 )
+    {
+      continue;
+    }
+
+    fmt::print( os, "Size-Class: {:4} Allocated: {:7} Peak-Live: {:7}\n",
+        ( i + 1 ) * event_t::ALLOC_GRANULARITY,
+        size_class.allocated_events,
+        size_class.peak_live_events );
+  }
 #endif
 }
 
@@ -886,6 +921,20 @@ void print_raid_scale_factors( std::ostream& os, sim_t* sim )
 
     fmt::print( os, "\n" );
   }
+
+  if ( sim->scaling->num_scaling_stats > 0 )
+  {
+    fmt::print( os, "  {:<{}}", "Seconds", max_name_length );
+    for ( stat_e j = STAT_NONE; j < STAT_MAX; j++ )
+    {
+      if ( sim->scaling->stat_time[ j ] != chrono::wall_clock::duration::zero() )
+      {
+        fmt::print( os, "  {}={:.3f}", util::stat_type_abbrev( j ),
+            chrono::to_fp_seconds( sim->scaling->stat_time[ j ] ) );
+      }
+    }
+    fmt::print( os, "\n" );
+  }
 }
 
 void print_player_scale_factors( std::ostream& os, const player_t& p,
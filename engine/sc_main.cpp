@@ -4,6 +4,7 @@
 // ==========================================================================
 
 #include "class_modules/class_module.hpp"
+#include "dbc/data_bundle.hpp"
 #include "dbc/dbc.hpp"
 #include "dbc/spell_query/spell_data_expr.hpp"
 #include "interfaces/bcp_api.hpp"
@@ -17,11 +18,27 @@
 #include "sim/sc_sim.hpp"
 #include "sim/scale_factor_control.hpp"
 #include "sim/sim_control.hpp"
+#include "util/chrono.hpp"
+#include "util/concurrency.hpp"
 #include "util/git_info.hpp"
 #include "util/io.hpp"
 
+#include "rapidjson/document.h"
+#include "rapidjson/error/en.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+#include <algorithm>
+#include <cstdio>
 #include <iostream>
 #include <locale>
+#include <sstream>
+
+#if defined( SC_WINDOWS )
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 #ifdef SC_SIGACTION
 #include <csignal>
@@ -236,10 +253,253 @@ struct special_effect_initializer_t
   { unique_gear::unregister_special_effects(); }
 };
 
-void print_version_info(const dbc_t& dbc)
+void print_version_info(const dbc_t& dbc, std::ostream& out = std::cout)
 {
-  std::cout << util::version_info_str( &dbc ) << std::endl << std::endl;
-  std::flush(std::cout);
+  out << util::version_info_str( &dbc ) << std::endl << std::endl;
+  std::flush(out);
+}
+
+// Job server ===============================================================
+
+/* Long-running server mode, enabled with server=1. Jobs are read from stdin,
+ * one JSON object per line:
+ *
+ *   {"id":<any>,"args":["option=value",...],"profile":"<simc profile text>"}
+ *
+ * Both "args" and "profile" are optional and are applied on top of the
+ * options given on the command line. Each job is answered with one line on
+ * stdout, in the order the jobs were received:
+ *
+ *   {"id":<id>,"status":"ok","elapsed_seconds":<s>,"report":<JSON report>}
+ *   {"id":<id>,"status":"error","elapsed_seconds":<s>,"error":"<message>"}
+ *
+ * Spell data, hotfixes and special effects are initialized once for the
+ * lifetime of the process, and sim threads are parked between jobs instead
+ * of being torn down.
+ */
+struct job_server_t
+{
+  const option_db_t& base_options;
+  FILE* out;
+  unsigned n_jobs;
+  unsigned n_failed;
+
+  job_server_t( const option_db_t& options ) :
+    base_options( options ), out( open_response_stream() ), n_jobs( 0 ), n_failed( 0 )
+  { }
+
+  ~job_server_t()
+  {
+    if ( out )
+    {
+      fclose( out );
+    }
+  }
+
+  // Hand the real stdout to the server responses, and point file descriptor 1 at stderr so
+  // that anything else the simulator prints cannot corrupt the response stream.
+  static FILE* open_response_stream()
+  {
+    fflush( stdout );
+#if defined( SC_WINDOWS )
+    int fd = _dup( _fileno( stdout ) );
+    _dup2( _fileno( stderr ), _fileno( stdout ) );
+    return fd == -1 ? nullptr : _fdopen( fd, "w" );
+#else
+    int fd = dup( fileno( stdout ) );
+    dup2( fileno( stderr ), fileno( stdout ) );
+    return fd == -1 ? nullptr : fdopen( fd, "w" );
+#endif
+  }
+
+  static std::vector<std::string> job_args( const rapidjson::Value& args )
+  {
+    if ( !args.IsArray() )
+    {
+      throw std::invalid_argument( "Job 'args' must be an array of strings" );
+    }
+
+    std::vector<std::string> result;
+    for ( const auto& arg : args.GetArray() )
+    {
+      if ( !arg.IsString() )
+      {
+        throw std::invalid_argument( "Job 'args' must be an array of strings" );
+      }
+      result.emplace_back( arg.GetString(), arg.GetStringLength() );
+    }
+
+    return result;
+  }
+
+  void simulate( sim_t& sim, const rapidjson::Document& job )
+  {
+    sim_control_t control;
+    control.options = base_options;
+
+    if ( job.HasMember( "args" ) )
+    {
+      control.options.parse_args( job_args( job[ "args" ] ) );
+    }
+
+    if ( job.HasMember( "profile" ) )
+    {
+      if ( !job[ "profile" ].IsString() )
+      {
+        throw std::invalid_argument( "Job 'profile' must be a string" );
+      }
+      control.options.parse_text( job[ "profile" ].GetString() );
+    }
+
+    sim.setup( &control );
+    sim.report_progress = 0;
+
+    if ( sim.canceled || !sim.execute() )
+    {
+      throw std::runtime_error( "Simulation was canceled." );
+    }
+
+    sim.scaling -> analyze();
+    sim.plot -> analyze();
+    sim.reforge_plot -> analyze();
+
+    if ( sim.canceled || !sim.profilesets.iterate( &sim ) )
+    {
+      throw std::runtime_error( "Simulation was canceled." );
+    }
+  }
+
+  void serve( const std::string& line )
+  {
+    auto start = chrono::wall_clock::now();
+    rapidjson::Document job;
+    rapidjson::Value id;
+    std::string error;
+
+    sim_t sim;
+    sim_t* main_sim = sim_signal_handler_t::global_sim;
+    sim_signal_handler_t::global_sim = &sim;
+
+    try
+    {
+      job.Parse( line.c_str(), line.size() );
+      if ( job.HasParseError() )
+      {
+        throw std::invalid_argument( fmt::format( "Invalid job JSON at offset {}: {}", job.GetErrorOffset(),
+                                                  rapidjson::GetParseError_En( job.GetParseError() ) ) );
+      }
+      if ( !job.IsObject() )
+      {
+        throw std::invalid_argument( "Job must be a JSON object" );
+      }
+      if ( job.HasMember( "id" ) )
+      {
+        id.CopyFrom( job[ "id" ], job.GetAllocator() );
+      }
+
+      simulate( sim, job );
+    }
+    catch ( const std::exception& e )
+    {
+      std::ostringstream s;
+      util::print_chained_exception( e, s );
+      error = s.str();
+      ++n_failed;
+    }
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer( buffer );
+    writer.StartObject();
+    writer.Key( "id" );
+    id.Accept( writer );
+    writer.Key( "status" );
+    writer.String( error.empty() ? "ok" : "error" );
+    writer.Key( "elapsed_seconds" );
+    writer.Double( chrono::elapsed_fp_seconds( start ) );
+    if ( !error.empty() )
+    {
+      writer.Key( "error" );
+      writer.String( error.c_str(), as<rapidjson::SizeType>( error.size() ) );
+      writer.EndObject();
+      fmt::print( out, "{}\n", buffer.GetString() );
+    }
+    else
+    {
+      // The report is streamed straight into the response object
+      fmt::print( out, "{},\"report\":", buffer.GetString() );
+      report::print_json( sim, out );
+      fmt::print( out, "}}\n" );
+    }
+    fflush( out );
+
+    sim_signal_handler_t::global_sim = main_sim;
+    ++n_jobs;
+  }
+
+  int run()
+  {
+    if ( !out )
+    {
+      throw std::runtime_error( "Unable to open server response stream" );
+    }
+
+    sc_thread_t::reuse_threads( true );
+
+    auto start = chrono::wall_clock::now();
+    std::string line;
+    while ( std::getline( std::cin, line ) )
+    {
+      if ( !line.empty() && line.back() == '\r' )
+      {
+        line.pop_back();
+      }
+
+      if ( line.find_first_not_of( " \t" ) == std::string::npos )
+      {
+        continue;
+      }
+
+      serve( line );
+    }
+
+    fmt::print( stderr, "Served {} jobs ({} failed) in {:.3f} seconds.\n", n_jobs, n_failed,
+                chrono::elapsed_fp_seconds( start ) );
+
+    return 0;
+  }
+};
+
+// Strips the server option from the command line options, returning true if server mode was
+// requested.
+bool server_mode( option_db_t& options )
+{
+  auto it = range::find_if( options, []( const option_tuple_t& opt ) { return opt.name == "server"; } );
+  if ( it == options.end() )
+  {
+    return false;
+  }
+
+  bool enabled = it -> value != "0";
+  options.erase( it );
+  return enabled;
+}
+
+// Strips the named option from the command line options, returning its last value, or an empty
+// string if it was not given.
+std::string strip_option( option_db_t& options, const std::string& name )
+{
+  std::string value;
+  auto it = std::remove_if( options.begin(), options.end(), [ &name, &value ]( const option_tuple_t& opt ) {
+    if ( opt.name != name )
+    {
+      return false;
+    }
+
+    value = opt.value;
+    return true;
+  } );
+  options.erase( it, options.end() );
+  return value;
 }
 
 } // anonymous namespace ====================================================
@@ -260,8 +520,6 @@ int sim_t::main( const std::vector<std::string>& args )
 
     special_effect_initializer_t special_effect_init;
 
-    print_version_info(*dbc);
-
     sim_control_t control;
 
     try
@@ -270,13 +528,46 @@ int sim_t::main( const std::vector<std::string>& args )
     }
     catch (const std::exception&) {
 
+      print_version_info(*dbc);
       std::throw_with_nested(std::invalid_argument("Incorrect option format"));
     }
 
+    // The client data bundle replaces compiled-in tables, and has to be loaded before anything
+    // accesses them
+    auto bundle = strip_option( control.options, "dbc_bundle" );
+    auto bundle_output = strip_option( control.options, "dbc_bundle_output" );
+    if ( !bundle.empty() )
+    {
+      dbc::bundle::load( bundle );
+    }
+
+    if ( !bundle_output.empty() )
+    {
+      dbc::bundle::write( bundle_output );
+      fmt::print( "Client data bundle written to '{}'.\n", bundle_output );
+      return 0;
+    }
+
+    bool server = server_mode( control.options );
+
+    print_version_info( *dbc, server ? std::cerr : std::cout );
+
     // Hotfixes are applies right before the sim context (control) is created, and simulator setup
     // begins
     hotfix::apply();
 
+    if ( server )
+    {
+      // Jobs share the already applied hotfixes and the command line options as their base
+      try
+      {
+        return job_server_t( control.options ).run();
+      }
+      catch( const std::exception& ){
+        std::throw_with_nested(std::runtime_error("Server failure"));
+      }
+    }
+
     try
     {
       setup( &control );
@@ -39,11 +39,21 @@ constexpr unsigned next_power_of_two( unsigned v )
 // as such there are rules of use that must be honored:
 //
 // (1) The pure virtual execute() method MUST be implemented in the sub-class
-// (2) There is 1 * sizeof( event_t ) space available to extend the sub-class
+// (2) Sub-classes may be at most event_t::MAX_SIZE bytes in size. Events are
+//     allocated from size classes in multiples of a cache line, so keeping them
+//     small still pays off
 // (3) event_manager_t is responsible for deleting the memory associated with allocated events
 // (4) create events throug make_event method
 struct event_t : private noncopyable
 {
+  static constexpr std::size_t ALLOC_GRANULARITY = 64;
+  static constexpr unsigned N_SIZE_CLASSES = 8;
+  static constexpr std::size_t MAX_SIZE = ALLOC_GRANULARITY * N_SIZE_CLASSES;
+
+  /// Allocation size class of an event of the given size
+  static constexpr unsigned size_class_of( std::size_t size )
+  { return size ? static_cast<unsigned>( ( size - 1 ) / ALLOC_GRANULARITY ) : 0; }
+
   sim_t& _sim;
   event_t*    next;
   timespan_t  time;
@@ -52,6 +62,7 @@ struct event_t : private noncopyable
   bool        canceled;
   bool        recycled;
   bool scheduled;
+  uint8_t     size_class;
 #ifdef ACTOR_EVENT_BOOKKEEPING
   actor_t*    actor;
 #endif
@@ -120,9 +131,10 @@ inline Event* make_event( sim_t& sim, Args&&... args )
 {
   static_assert( std::is_base_of<event_t, Event>::value,
                  "Event must be derived from event_t" );
-  static_assert( sizeof( Event ) <= util::next_power_of_two( 2 * sizeof( event_t ) ),
-                 "Event type is too big" );
+  static_assert( sizeof( Event ) <= event_t::MAX_SIZE, "Event type is too big" );
+  static_assert( alignof( Event ) <= event_t::ALLOC_GRANULARITY, "Event type is over-aligned" );
   auto r = new ( sim ) Event( std::forward<Args>(args)... );
+  r -> size_class = event_t::size_class_of( sizeof( Event ) );
   assert( r -> id != 0 && "Event not added to event manager!" );
   return r;
 }
@@ -10,61 +10,85 @@
 #include "player/actor.hpp"
 
 
+namespace {
+
+/// Index of the lowest set bit of a non-zero word
+inline unsigned lowest_set_bit( uint64_t v )
+{
+  assert( v != 0 );
+#if defined( SC_VS )
+  unsigned long idx;
+  _BitScanForward64( &idx, v );
+  return static_cast<unsigned>( idx );
+#else
+  return static_cast<unsigned>( __builtin_ctzll( v ) );
+#endif
+}
+
+/// First occupied slot at or after start on a wheel level, WHEEL_SLOTS if none
+unsigned find_occupied_slot( const event_manager_t::wheel_level_t& level, unsigned start )
+{
+  for ( unsigned word = start / 64; word < level.occupied.size(); ++word )
+  {
+    uint64_t bits = level.occupied[ word ];
+    if ( word == start / 64 )
+    {
+      bits &= ~uint64_t( 0 ) << ( start % 64 );
+    }
+
+    if ( bits )
+    {
+      return word * 64 + lowest_set_bit( bits );
+    }
+  }
+
+  return event_manager_t::WHEEL_SLOTS;
+}
+
+} // unnamed namespace
+
 event_manager_t::event_manager_t( sim_t* s )
   : sim( s ),
     events_remaining( 0 ),
     events_processed( 0 ),
     total_events_processed( 0 ),
     max_events_remaining( 0 ),
-    timing_slice( 0 ),
     global_event_id( 1 ),  // start at 1, so we can identify event -> id == 0
                            // meaning a unscheduled event.
     timing_wheel(),
-    recycled_event_list( nullptr ),
-    wheel_seconds( 0 ),
-    wheel_size( 0 ),
-    wheel_mask( 0 ),
-    wheel_shift( 5 ),
-    wheel_granularity( 0.0 ),
-    wheel_time( timespan_t::zero() ),
+    far_event_list( nullptr ),
+    wheel_cursor( 0 ),
+    size_classes(),
     event_stopwatch(),
-#ifdef EVENT_QUEUE_DEBUG
     monitor_cpu( false ),
+    canceled( false )
+#ifdef EVENT_QUEUE_DEBUG
+    ,
     max_queue_depth( 0 ),
     n_allocated_events( 0 ),
     n_requested_events( 0 ),
-    n_end_insert( 0 ),
-    events_traversed( 0 ),
-    events_added( 0 )
-#else
-    monitor_cpu( false ),
-    canceled( false )
+    events_added( 0 ),
+    events_cascaded( 0 ),
+    event_queue_level_samples()
 #endif /* EVENT_QUEUE_DEBUG */
 {
   allocated_events.reserve( 100 );
+  wheel_clear();
 }
 
 // event_manager_t::~event_manager_t ========================================
 
-event_manager_t::~event_manager_t()
-{
-  while ( recycled_event_list )
-  {
-    event_t* e          = recycled_event_list;
-    recycled_event_list = e->next;
-    free( e );
-  }
-}
+// Event memory is owned by the size class allocators
+event_manager_t::~event_manager_t() = default;
 
 // event_manager_t::allocate_event ==========================================
 
 void* event_manager_t::allocate_event( const std::size_t size )
 {
-  static constexpr std::size_t SIZE = util::next_power_of_two( 2 * sizeof( event_t ) );
-  assert( SIZE > size );
-  (void)size;
+  assert( size <= event_t::MAX_SIZE );
 
-  event_t* e = recycled_event_list;
+  auto& size_class = size_classes[ event_t::size_class_of( size ) ];
+  event_t* e = size_class.recycled_event_list;
 #ifdef EVENT_QUEUE_DEBUG
   n_requested_events++;
   if ( size >= event_requested_size_count.size() )
@@ -75,23 +99,22 @@ void* event_manager_t::allocate_event( const std::size_t size )
 #endif
   if ( e )
   {
-    recycled_event_list = e->next;
+    size_class.recycled_event_list = e->next;
   }
   else
   {
-    e = (event_t*)malloc( SIZE );
-
-    if ( !e )
-    {
-      throw std::bad_alloc();
-    }
-    else
-    {
+    const std::size_t block_size = ( event_t::size_class_of( size ) + 1 ) * event_t::ALLOC_GRANULARITY;
+    e = static_cast<event_t*>( size_class.allocator.allocate( block_size, event_t::ALLOC_GRANULARITY ) );
 #ifdef EVENT_QUEUE_DEBUG
-      n_allocated_events++;
+    n_allocated_events++;
 #endif
-      allocated_events.push_back( e );
-    }
+    size_class.allocated_events++;
+    allocated_events.push_back( e );
+  }
+
+  if ( ++size_class.live_events > size_class.peak_live_events )
+  {
+    size_class.peak_live_events = size_class.live_events;
   }
 
   return e;
@@ -101,10 +124,12 @@ void* event_manager_t::allocate_event( const std::size_t size )
 
 void event_manager_t::recycle_event( event_t* e )
 {
+  auto& size_class = size_classes[ e->size_class ];
   e->~event_t();
-  e->recycled         = true;
-  e->next             = recycled_event_list;
-  recycled_event_list = e;
+  e->recycled                    = true;
+  e->next                        = size_class.recycled_event_list;
+  size_class.recycled_event_list = e;
+  size_class.live_events--;
 }
 
 // event_manager_t::add_event ===============================================
@@ -117,75 +142,164 @@ void event_manager_t::add_event( event_t* e, timespan_t delta_time )
   if ( delta_time < timespan_t::zero() )
     delta_time = timespan_t::zero();
 
-  if ( delta_time > wheel_time )
-  {
-    e->time = current_time + wheel_time - timespan_t::from_seconds( 1 );
-    e->reschedule_time = current_time + delta_time;
-  }
-  else
+  e->time            = current_time + delta_time;
+  e->reschedule_time = timespan_t::zero();
+
+#ifdef EVENT_QUEUE_DEBUG
+  unsigned level = wheel_insert( e );
+  events_added++;
+  event_queue_level_samples[ level ]++;
+#else
+  wheel_insert( e );
+#endif
+
+  if ( ++events_remaining > max_events_remaining )
+    max_events_remaining = events_remaining;
+
+  if ( sim->debug )
+    sim->print_debug( "Add Event: {} time={}", *e, e->time );
+
+#ifdef ACTOR_EVENT_BOOKKEEPING
+  if ( sim->debug && e->actor )
   {
-    e->time            = current_time + delta_time;
-    e->reschedule_time = timespan_t::zero();
+    e->actor->event_counter++;
+    sim->print_debug( "Actor {} has {} scheduled events", e->actor->name(),
+                           e->actor->event_counter );
   }
+#endif
+}
 
-  // Determine the timing wheel position to which the event will belong
-  // Only valid for integer based timespan_t
-  uint32_t slice = static_cast<uint32_t>(
-      ( e->time.total_millis() >> wheel_shift ) & wheel_mask );
+// event_manager_t::wheel_insert ============================================
 
-  // Insert event into the event list at the appropriate time
-  event_t** prev = &( timing_wheel[ slice ] );
-#ifdef EVENT_QUEUE_DEBUG
-  unsigned traversed = 0;
-#endif
+/// Place an event on the lowest timing wheel level that shares its window with
+/// the wheel cursor. Returns the level used (WHEEL_LEVELS for the far list).
+unsigned event_manager_t::wheel_insert( event_t* e )
+{
+  const auto time = static_cast<uint64_t>( e->time.total_millis() );
+  assert( time >= wheel_cursor );
+  const uint64_t window = time ^ wheel_cursor;
 
-  while ( ( *prev ) &&
-          ( *prev )->time <= e->time )  // Find position in the list
+  for ( unsigned level = 0; level < WHEEL_LEVELS; ++level )
   {
-    prev = &( ( *prev )->next );
+    if ( window >> ( WHEEL_BITS * ( level + 1 ) ) )
+    {
+      continue;
+    }
+
+    auto index = static_cast<unsigned>( ( time >> ( WHEEL_BITS * level ) ) & WHEEL_MASK );
+    auto& wheel = timing_wheel[ level ];
+    auto& slot  = wheel.slots[ index ];
 #ifdef EVENT_QUEUE_DEBUG
-    traversed++;
+    unsigned depth = 0;
+    for ( event_t* i = slot.head; i; i = i->next )
+    {
+      depth++;
+    }
+    if ( depth > max_queue_depth )
+    {
+      max_queue_depth = depth;
+    }
+    if ( depth >= event_queue_depth_samples.size() )
+    {
+      event_queue_depth_samples.resize( depth + 1 );
+    }
+    event_queue_depth_samples[ depth ]++;
 #endif
+
+    e->next = nullptr;
+    if ( slot.tail )
+    {
+      slot.tail->next = e;
+    }
+    else
+    {
+      slot.head = e;
+      wheel.occupied[ index / 64 ] |= uint64_t( 1 ) << ( index % 64 );
+    }
+    slot.tail = e;
+
+    return level;
   }
-#ifdef EVENT_QUEUE_DEBUG
-  events_added++;
-  events_traversed += traversed;
-  if ( traversed > max_queue_depth )
+
+  // Beyond the horizon of the wheel (~50 days); keep ordered by ( time, id ).
+  event_t** prev = &far_event_list;
+  while ( *prev && ( *prev )->time <= e->time )
   {
-    max_queue_depth = traversed;
+    prev = &( ( *prev )->next );
   }
-  if ( traversed >= event_queue_depth_samples.size() )
+  e->next = *prev;
+  *prev   = e;
+
+  return WHEEL_LEVELS;
+}
+
+// event_manager_t::wheel_cascade ===========================================
+
+/// Advance the wheel cursor to the next occupied slot above level 0, and
+/// redistribute its events to the lower levels. Returns false if there are no
+/// events left anywhere on the wheel.
+bool event_manager_t::wheel_cascade()
+{
+  event_t* list = nullptr;
+
+  for ( unsigned level = 1; level < WHEEL_LEVELS && !list; ++level )
   {
-    event_queue_depth_samples.resize( traversed + 1 );
+    const unsigned shift = WHEEL_BITS * level;
+    const auto current   = static_cast<unsigned>( ( wheel_cursor >> shift ) & WHEEL_MASK );
+    const unsigned index = find_occupied_slot( timing_wheel[ level ], current + 1 );
+    if ( index == WHEEL_SLOTS )
+    {
+      continue;
+    }
+
+    auto& wheel = timing_wheel[ level ];
+    auto& slot  = wheel.slots[ index ];
+    list        = slot.head;
+    slot.head = slot.tail = nullptr;
+    wheel.occupied[ index / 64 ] &= ~( uint64_t( 1 ) << ( index % 64 ) );
+
+    const uint64_t window_mask = ( uint64_t( 1 ) << ( shift + WHEEL_BITS ) ) - 1;
+    wheel_cursor = ( wheel_cursor & ~window_mask ) | ( uint64_t( index ) << shift );
   }
-  event_queue_depth_samples[ traversed ].first++;
-  if ( !(*prev) )
+
+  if ( !list )
   {
-    event_queue_depth_samples[ traversed ].second++;
-    if ( traversed )
+    if ( !far_event_list )
     {
-      n_end_insert++;
+      return false;
     }
+
+    list           = far_event_list;
+    far_event_list = nullptr;
+    wheel_cursor   = static_cast<uint64_t>( list->time.total_millis() );
   }
+
+  // Lists preserve insertion order for equal times, so appending in list order
+  // keeps the ( time, id ) ordering intact.
+  while ( list )
+  {
+    event_t* e = list;
+    list       = e->next;
+    wheel_insert( e );
+#ifdef EVENT_QUEUE_DEBUG
+    events_cascaded++;
 #endif
-  // insert event
-  e->next = *prev;
-  *prev   = e;
+  }
 
-  if ( ++events_remaining > max_events_remaining )
-    max_events_remaining = events_remaining;
+  return true;
+}
 
-  if ( sim->debug )
-    sim->print_debug( "Add Event: {} time={} reschedule={}", *e, e->time, e->reschedule_time );
+// event_manager_t::wheel_clear =============================================
 
-#ifdef ACTOR_EVENT_BOOKKEEPING
-  if ( sim->debug && e->actor )
+void event_manager_t::wheel_clear()
+{
+  for ( auto& level : timing_wheel )
   {
-    e->actor->event_counter++;
-    sim->print_debug( "Actor {} has {} scheduled events", e->actor->name(),
-                           e->actor->event_counter );
+    level.slots.fill( { nullptr, nullptr } );
+    level.occupied.fill( 0 );
   }
-#endif
+  far_event_list = nullptr;
+  wheel_cursor   = 0;
 }
 
 // event_manager_t::reschedule_event ========================================
@@ -293,38 +407,14 @@ void event_manager_t::flush()
   }
 
   // Clear Timing Wheel
-  timing_wheel.assign( timing_wheel.size(), nullptr );
+  wheel_clear();
 }
 
 // event_manager_t::init ====================================================
 
 void event_manager_t::init()
 {
-  // Timing wheel depth defaults to about 17 minutes with a granularity of 32
-  // buckets per second.
-  // This makes wheel_size = 32K and it's fully used.
-  if ( wheel_seconds < 1024 )
-    wheel_seconds = 1024;  // 2^10 Min to ensure limited wrap-around
-  if ( wheel_granularity <= 0 )
-    wheel_granularity = 32;  // 2^5 Time slices per second
-
-  wheel_time = timespan_t::from_seconds( wheel_seconds );
-
-  // Only valid for integer based timespan_t
-  wheel_size = ( uint32_t )( wheel_time.total_millis() >> wheel_shift );
-
-  // Round up the wheel depth to the nearest power of 2 to enable a fast "mod"
-  // operation.
-  for ( wheel_mask = 2; wheel_mask < wheel_size; wheel_mask *= 2 )
-  {
-    continue;
-  }
-  wheel_size = wheel_mask;
-  wheel_mask--;
-
-  // The timing wheel represents an array of event lists: Each time slice has an
-  // event list.
-  timing_wheel.resize( wheel_size );
+  wheel_clear();
 }
 
 // event_manager_t::next_event ==============================================
@@ -336,25 +426,33 @@ event_t* event_manager_t::next_event()
 
   while ( true )
   {
-    event_t*& event_list = timing_wheel[ timing_slice ];
-    if ( event_list )
+    auto& wheel = timing_wheel[ 0 ];
+    const unsigned index =
+        find_occupied_slot( wheel, static_cast<unsigned>( wheel_cursor & WHEEL_MASK ) );
+    if ( index < WHEEL_SLOTS )
     {
-      event_t* e = event_list;
-      event_list = e->next;
+      auto& slot = wheel.slots[ index ];
+      event_t* e = slot.head;
+      slot.head  = e->next;
+      if ( !slot.head )
+      {
+        slot.tail = nullptr;
+        wheel.occupied[ index / 64 ] &= ~( uint64_t( 1 ) << ( index % 64 ) );
+      }
+      e->next = nullptr;
+
+      wheel_cursor = ( wheel_cursor & ~uint64_t( WHEEL_MASK ) ) | index;
       events_remaining--;
       events_processed++;
       return e;
     }
 
-    timing_slice++;
-    if ( timing_slice == timing_wheel.size() )
+    if ( !wheel_cascade() )
     {
-      timing_slice = 0;
-      // Time Wheel turns around.
+      assert( false && "Event queue is empty with events remaining" );
+      return nullptr;
     }
   }
-
-  return nullptr;
 }
 
 // event_manager_t::reset ===================================================
@@ -363,7 +461,7 @@ void event_manager_t::reset()
 {
   events_remaining = 0;
   events_processed = 0;
-  timing_slice     = 0;
+  wheel_cursor     = 0;
   global_event_id  = 0;
   canceled         = false;
   current_time     = timespan_t::zero();
@@ -376,11 +474,16 @@ void event_manager_t::merge( event_manager_t& other )
   max_events_remaining =
       std::max( max_events_remaining, other.max_events_remaining );
   total_events_processed += other.total_events_processed;
+  for ( size_t i = 0; i < size_classes.size(); ++i )
+  {
+    size_classes[ i ].peak_live_events =
+        std::max( size_classes[ i ].peak_live_events, other.size_classes[ i ].peak_live_events );
+    size_classes[ i ].allocated_events += other.size_classes[ i ].allocated_events;
+  }
 #ifdef EVENT_QUEUE_DEBUG
-  events_traversed += other.events_traversed;
   events_added += other.events_added;
+  events_cascaded += other.events_cascaded;
   n_allocated_events += other.n_allocated_events;
-  n_end_insert += other.n_end_insert;
   n_requested_events += other.n_requested_events;
   if ( other.max_queue_depth > max_queue_depth )
   {
@@ -395,10 +498,16 @@ void event_manager_t::merge( event_manager_t& other )
 
   for ( size_t i = 0; i < other.event_queue_depth_samples.size(); ++i )
   {
-    event_queue_depth_samples[ i ].first +=
-        other.event_queue_depth_samples[ i ].first;
-    event_queue_depth_samples[ i ].second +=
-        other.event_queue_depth_samples[ i ].second;
+    event_queue_depth_samples[ i ] += other.event_queue_depth_samples[ i ];
+  }
+  for ( size_t i = 0; i < event_queue_level_samples.size(); ++i )
+  {
+    event_queue_level_samples[ i ] += other.event_queue_level_samples[ i ];
+  }
+  if ( other.event_requested_size_count.size() >
+       event_requested_size_count.size() )
+  {
+    event_requested_size_count.resize( other.event_requested_size_count.size() );
   }
   for ( size_t i = 0; i < other.event_requested_size_count.size(); ++i )
   {
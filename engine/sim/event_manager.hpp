@@ -6,40 +6,77 @@
 #pragma once
 
 #include "config.hpp"
+#include "sim/event.hpp"
+#include "util/allocator.hpp"
 #include "util/timespan.hpp"
 #include "util/chrono.hpp"
 #include "util/stopwatch.hpp"
 
+#include <array>
 #include <cstdint>
 #include <vector>
 
-struct event_t;
 struct sim_t;
 
 // Event manager
+//
+// Events are kept in a hierarchical timing wheel. Level 0 has one slot per
+// millisecond, and each further level covers the full span of the level below
+// it in each of its slots. An event is placed at the lowest level whose window
+// it shares with the wheel cursor; when the cursor leaves a window, the next
+// occupied slot of the level above is cascaded down. Each slot is a FIFO list,
+// so events with equal time are always executed in ( time, id ) order.
 struct event_manager_t
 {
+  static constexpr unsigned WHEEL_LEVELS = 4;
+  static constexpr unsigned WHEEL_BITS = 8;
+  static constexpr unsigned WHEEL_SLOTS = 1u << WHEEL_BITS;
+  static constexpr unsigned WHEEL_MASK = WHEEL_SLOTS - 1;
+
+  struct wheel_slot_t
+  {
+    event_t* head;
+    event_t* tail;
+  };
+
+  struct wheel_level_t
+  {
+    std::array<wheel_slot_t, WHEEL_SLOTS> slots;
+    std::array<uint64_t, WHEEL_SLOTS / 64> occupied;
+  };
+
+  // Events of one allocation size class are carved from their own cache line
+  // aligned pages, and recycled through a per-class free list.
+  struct event_size_class_t
+  {
+    util::bump_ptr_allocator_t<16384> allocator;
+    event_t* recycled_event_list = nullptr;
+    unsigned live_events = 0, peak_live_events = 0, allocated_events = 0;
+  };
+
   sim_t* sim;
   timespan_t current_time;
   uint64_t events_remaining;
   uint64_t events_processed;
   uint64_t total_events_processed;
   uint64_t max_events_remaining;
-  unsigned timing_slice, global_event_id;
-  std::vector<event_t*> timing_wheel;
-  event_t* recycled_event_list;
-  int    wheel_seconds, wheel_size, wheel_mask, wheel_shift;
-  double wheel_granularity;
-  timespan_t wheel_time;
+  unsigned global_event_id;
+  std::array<wheel_level_t, WHEEL_LEVELS> timing_wheel;
+  // Events beyond the horizon of the top wheel level, sorted by ( time, id )
+  event_t* far_event_list;
+  uint64_t wheel_cursor;
+  std::array<event_size_class_t, event_t::N_SIZE_CLASSES> size_classes;
   std::vector<event_t*> allocated_events;
 
   stopwatch_t<chrono::thread_clock> event_stopwatch;
   bool monitor_cpu;
   bool canceled;
 #ifdef EVENT_QUEUE_DEBUG
-  unsigned max_queue_depth, n_allocated_events, n_end_insert, n_requested_events;
-  uint64_t events_traversed, events_added;
-  std::vector<std::pair<unsigned, unsigned> > event_queue_depth_samples;
+  unsigned max_queue_depth, n_allocated_events, n_requested_events;
+  uint64_t events_added, events_cascaded;
+  // Number of events already in the destination slot at insert time
+  std::vector<uint64_t> event_queue_depth_samples;
+  std::array<uint64_t, WHEEL_LEVELS + 1> event_queue_level_samples;
   std::vector<unsigned> event_requested_size_count;
 #endif /* EVENT_QUEUE_DEBUG */
 
@@ -56,4 +93,9 @@ struct event_manager_t
   void init();
   void reset();
   void merge( event_manager_t& other );
-};
\ No newline at end of file
+
+private:
+  unsigned wheel_insert( event_t* );
+  bool wheel_cascade();
+  void wheel_clear();
+};
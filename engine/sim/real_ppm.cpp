@@ -73,16 +73,18 @@ double real_ppm_t::proc_chance( player_t* player, double PPM, timespan_t last_tr
   return rppm_chance;
 }
 
+bool real_ppm_t::can_trigger() const
+{
+  return freq > 0 && last_trigger_attempt != player->sim->current_time();
+}
+
 bool real_ppm_t::trigger()
 {
-  if ( freq <= 0 )
+  if ( !can_trigger() )
   {
     return false;
   }
 
-  if ( last_trigger_attempt == player->sim->current_time() )
-    return false;
-
   // 2020-10-11: Instead of using the aboslute time to the last successful proc, it appears
   // that the amount of time that is added on each trigger attempt is capped at max_interval
   accumulated_blp += std::min( player->sim->current_time() - last_trigger_attempt, max_interval() );
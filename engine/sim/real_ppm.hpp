@@ -108,5 +108,9 @@ public:
     accumulated_blp = 0_ms;
   }
 
+  // False if trigger() fails without rolling: there is no frequency, or the proc was already
+  // attempted at the current time
+  bool can_trigger() const;
+
   bool trigger();
 };
@@ -32,6 +32,7 @@ struct recharge_event_t : event_t
   void execute() override
   {
     assert( cooldown_->current_charge < cooldown_->charges );
+    cooldown_->version++;
     cooldown_->current_charge++;
     cooldown_->ready = cooldown_t::ready_init();
 
@@ -107,7 +108,8 @@ cooldown_t::cooldown_t( util::string_view n, player_t& p ) :
   execute_types_mask( 0u ),
   current_charge( 1 ),
   recharge_multiplier( 1.0 ),
-  base_duration( 0_ms )
+  base_duration( 0_ms ),
+  version( 0 )
 { }
 
 cooldown_t::cooldown_t( util::string_view n, sim_t& s ) :
@@ -127,7 +129,8 @@ cooldown_t::cooldown_t( util::string_view n, sim_t& s ) :
   execute_types_mask( 0u ),
   current_charge( 1 ),
   recharge_multiplier( 1.0 ),
-  base_duration( 0_ms )
+  base_duration( 0_ms ),
+  version( 0 )
 { }
 
 /**
@@ -201,6 +204,8 @@ void cooldown_t::adjust_remaining_duration( double delta )
   assert( ongoing() && delta > 0.0 );
   assert( charges > 0 && "Cooldown charges must be positive");
 
+  version++;
+
   timespan_t new_remains, remains;
   if ( charges == 1 )
   {
@@ -245,6 +250,8 @@ void cooldown_t::adjust( timespan_t amount, bool require_reaction )
   if ( amount == 0_ms )
     return;
 
+  version++;
+
   // Normal cooldown, just adjust as we see fit
   if ( charges == 1 )
   {
@@ -332,6 +339,7 @@ void cooldown_t::adjust( timespan_t amount, bool require_reaction )
 
 void cooldown_t::reset_init()
 {
+  version++;
   ready = ready_init();
   last_start = 0_ms;
   last_charged = 0_ms;
@@ -349,6 +357,8 @@ void cooldown_t::reset( bool require_reaction, int charges_ )
 {
   if ( charges_ == 0 )
     return;
+
+  version++;
   if ( charges_ < 0 )
     charges_ = charges;
 
@@ -411,6 +421,7 @@ void cooldown_t::start( action_t* a, timespan_t _override, timespan_t delay )
     return;
   }
 
+  version++;
   reset_react = 0_ms;
   action = a;
 
@@ -504,7 +515,7 @@ timespan_t cooldown_t::cooldown_duration( const cooldown_t* cd )
 std::unique_ptr<expr_t> cooldown_t::create_expression( util::string_view name_str )
 {
   if ( name_str == "remains" )
-    return make_mem_fn_expr( name_str, *this, &cooldown_t::remains );
+    return expression::depends_on( make_mem_fn_expr( name_str, *this, &cooldown_t::remains ), &version, true );
   else if ( name_str == "base_duration" )
   {
     return make_fn_expr( name_str, [ this ]
@@ -525,10 +536,10 @@ std::unique_ptr<expr_t> cooldown_t::create_expression( util::string_view name_st
     } );
   }
   else if ( name_str == "up" || name_str == "ready" )
-    return make_mem_fn_expr( name_str, *this, &cooldown_t::up );
+    return expression::depends_on( make_mem_fn_expr( name_str, *this, &cooldown_t::up ), &version, true );
   else if ( name_str == "charges" )
   {
-    return make_fn_expr( name_str, [ this ]
+    return expression::depends_on( make_fn_expr( name_str, [ this ]
     {
       if ( charges <= 1 )
       {
@@ -538,7 +549,7 @@ std::unique_ptr<expr_t> cooldown_t::create_expression( util::string_view name_st
       {
         return as<double>( current_charge );
       }
-    } );
+    } ), &version, true );
   }
   else if ( name_str == "charges_fractional" )
     return make_mem_fn_expr( name_str, *this, &cooldown_t::charges_fractional );
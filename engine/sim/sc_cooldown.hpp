@@ -46,6 +46,9 @@ struct cooldown_t
   double recharge_multiplier;
   timespan_t base_duration;
 
+  // Bumped on every change to the cooldown progression, see expr_t::depends_on
+  uint64_t version;
+
   cooldown_t( util::string_view name, player_t& );
   cooldown_t( util::string_view name, sim_t& );
 
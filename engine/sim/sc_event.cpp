@@ -19,7 +19,8 @@ event_t::event_t( sim_t& s, actor_t* a )
     id( 0 ),
     canceled( false ),
     recycled( false ),
-    scheduled( false )
+    scheduled( false ),
+    size_class( 0 )
 #ifdef ACTOR_EVENT_BOOKKEEPING
     ,
     actor( a )
@@ -7,6 +7,7 @@
 #include "action/sc_action.hpp"
 #include "player/sc_player.hpp"
 #include "sim/sc_sim.hpp"
+#include <algorithm>
 #include <atomic>
 
 namespace expression
@@ -159,6 +160,11 @@ public:
   {
     return F()( input->eval() );
   }
+
+  void collect_dependencies( dependency_set_t& dependencies ) override
+  {
+    input->collect_dependencies( dependencies );
+  }
 };
 
 namespace unary
@@ -245,6 +251,12 @@ public:
     assert(left);
     assert(right);
   }
+
+  void collect_dependencies( dependency_set_t& dependencies ) override
+  {
+    left->collect_dependencies( dependencies );
+    right->collect_dependencies( dependencies );
+  }
 };
 
 class logical_and_t : public binary_base_t
@@ -815,6 +827,10 @@ public:
         {
           return static_cast<double>( F<T>()( static_cast<T>( left ), static_cast<T>( right->eval() ) ) );
         }
+        void collect_dependencies( dependency_set_t& dependencies ) override
+        {
+          right->collect_dependencies( dependencies );
+        }
       };
       return std::make_unique<left_reduced_t>(
           fmt::format( "{}_left_reduced('{}')", name(), left->name() ),
@@ -837,6 +853,10 @@ public:
         {
           return static_cast<double>( F<T>()( static_cast<T>( left->eval() ), static_cast<T>( right ) ) );
         }
+        void collect_dependencies( dependency_set_t& dependencies ) override
+        {
+          left->collect_dependencies( dependencies );
+        }
       };
       return std::make_unique<right_reduced_t>(
           fmt::format( "{}_right_reduced('{}')", name(), left->name() ),
@@ -1203,6 +1223,56 @@ std::unique_ptr<expr_t> build_player_expression_tree(
   return res;
 }
 
+// memo_t ===================================================================
+
+memo_t::memo_t( expr_t& expr ) : time(), context( nullptr ), value( 0 ), valid( false )
+{
+  expr.collect_dependencies( dependencies );
+
+  // The same state may be read by several leaves
+  range::sort( dependencies.versions );
+  dependencies.versions.erase( std::unique( dependencies.versions.begin(), dependencies.versions.end() ),
+                               dependencies.versions.end() );
+  versions.resize( dependencies.versions.size() );
+}
+
+bool memo_t::lookup( timespan_t now, const void* ctx, double& v ) const
+{
+  if ( !valid || ctx != context || ( dependencies.time && now != time ) )
+  {
+    return false;
+  }
+
+  for ( size_t i = 0; i < versions.size(); ++i )
+  {
+    if ( *dependencies.versions[ i ] != versions[ i ] )
+    {
+      return false;
+    }
+  }
+
+  v = value;
+  return true;
+}
+
+void memo_t::store( timespan_t now, const void* ctx, double v )
+{
+  if ( dependencies.opaque )
+  {
+    return;
+  }
+
+  for ( size_t i = 0; i < versions.size(); ++i )
+  {
+    versions[ i ] = *dependencies.versions[ i ];
+  }
+
+  time    = now;
+  context = ctx;
+  value   = v;
+  valid   = true;
+}
+
 }  // expression
 
 #if !defined( NDEBUG )
@@ -1213,6 +1283,23 @@ int expr_t::get_global_id()
 }
 #endif
 
+// expr_t::collect_dependencies ============================================
+
+void expr_t::collect_dependencies( expression::dependency_set_t& dependencies )
+{
+  if ( !dependency_declared_ )
+  {
+    dependencies.opaque = true;
+    return;
+  }
+
+  if ( dependency_version_ )
+  {
+    dependencies.versions.push_back( dependency_version_ );
+  }
+  dependencies.time |= dependency_time_;
+}
+
 // build_expression_tree ====================================================
 
 static std::unique_ptr<expr_t> build_expression_tree(
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "config.hpp"
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <functional>
@@ -73,6 +74,40 @@ bool convert_to_rpn( std::vector<expr_token_t>& tokens );
 std::unique_ptr<expr_t> build_player_expression_tree(
     player_t& player, std::vector<expression::expr_token_t>& tokens,
     bool optimize );
+
+/* State read by an expression, collected from the declarations of its leaves ( see
+ * expr_t::depends_on ). Every source of state keeps a version counter it bumps on each change.
+ */
+struct dependency_set_t
+{
+  std::vector<const uint64_t*> versions;
+  bool time   = false;  // The result changes with the current time
+  bool opaque = false;  // Some leaf reads undeclared state, the result can never be reused
+};
+
+/* Caches the result of an expression for as long as the state it reads is unchanged, see
+ * sim_t::memoize_conditions. Results are only reused for the same context, and results of time
+ * dependent expressions only at the same timestamp.
+ */
+class memo_t
+{
+  dependency_set_t dependencies;
+  std::vector<uint64_t> versions;
+  timespan_t time;
+  const void* context;
+  double value;
+  bool valid;
+
+public:
+  memo_t( expr_t& expr );
+
+  // Whether results can be reused at all
+  bool reusable() const
+  { return !dependencies.opaque; }
+
+  bool lookup( timespan_t now, const void* context, double& value ) const;
+  void store( timespan_t now, const void* context, double value );
+};
 }
 
 /// Action expression
@@ -81,6 +116,10 @@ struct expr_t
 protected:
   expr_t( util::string_view name, expression::token_e op = expression::TOK_UNKNOWN )
     : op_( op )
+      ,
+      dependency_version_( nullptr ),
+      dependency_time_( false ),
+      dependency_declared_( false )
 #if !defined( NDEBUG )
       ,
       id_( get_global_id() ),
@@ -165,9 +204,28 @@ public:
     return false;
   }
 
+  /* Declares the state a leaf expression reads, for reusing its result while that state is
+  unchanged: the version counter of the state, if any, and whether the result changes with time.
+  */
+  void depends_on( const uint64_t* version, bool time = false )
+  {
+    dependency_version_  = version;
+    dependency_time_     = time;
+    dependency_declared_ = true;
+  }
+
+  /* Adds the state read by the expression to the set. By default the expression is a leaf, and
+  opaque unless it declared its dependencies.
+  */
+  virtual void collect_dependencies( expression::dependency_set_t& dependencies );
+
   expression::token_e op_;
 
 private:
+  const uint64_t* dependency_version_;
+  bool dependency_time_;
+  bool dependency_declared_;
+
   /* Attempts to create a optimized version of the expression.
   Should return null if no improved version can be built.
   */
@@ -203,6 +261,10 @@ public:
     *v = value;
     return true;
   }
+
+  void collect_dependencies( expression::dependency_set_t& ) override
+  {
+  }
 };
 
 // Reference Expression - ref_expr_t
@@ -280,6 +342,17 @@ inline std::unique_ptr<expr_t> make_mem_fn_expr( util::string_view name, T& t, F
   return make_fn_expr( name, std::bind( std::mem_fn( f ), &t ) );
 }
 
+namespace expression
+{
+// Declares the state read by a leaf expression, see expr_t::depends_on
+inline std::unique_ptr<expr_t> depends_on( std::unique_ptr<expr_t> expr, const uint64_t* version,
+                                           bool time = false )
+{
+  expr->depends_on( version, time );
+  return expr;
+}
+}  // namespace expression
+
 template<class T>
 inline std::unique_ptr<expr_t> expr_t::create_constant( util::string_view name, T value )
 {
@@ -392,6 +392,10 @@ struct opts_map_t : public option_t
     option_t( name ),
     _ref( ref )
   { }
+
+  bool match_prefix() const override
+  { return true; }
+
 protected:
   opts::parse_status do_parse( sim_t*, util::string_view n, util::string_view v ) const override
   {
@@ -439,6 +443,9 @@ struct opts_map_list_t : public option_t
     option_t( name ), _ref( ref )
   { }
 
+  bool match_prefix() const override
+  { return true; }
+
 protected:
   opts::parse_status do_parse( sim_t*, util::string_view n, util::string_view v ) const override
   {
@@ -610,6 +617,67 @@ opts::parse_status opts::parse( sim_t*                                      sim,
   return ret;
 }
 
+// option_index_t::parse ===================================================
+
+void opts::option_index_t::build( util::span<const std::unique_ptr<option_t>> options )
+{
+  _data = options.data();
+  _size = options.size();
+  _exact.clear();
+  _prefix.clear();
+
+  // Keys view the names of the options, the first option of a name takes precedence
+  for ( size_t i = 0; i < options.size(); ++i )
+  {
+    auto& index = options[ i ]->match_prefix() ? _prefix : _exact;
+    index.emplace( options[ i ]->name(), i );
+  }
+}
+
+opts::parse_status opts::option_index_t::parse( sim_t*                                      sim,
+                                                util::span<const std::unique_ptr<option_t>> options,
+                                                util::string_view                           name,
+                                                util::string_view                           value,
+                                                const parse_status_fn_t&                    status_fn )
+{
+  if ( options.data() != _data || options.size() != _size )
+  {
+    build( options );
+  }
+
+  auto first = options.size();
+
+  auto it = _exact.find( name );
+  if ( it != _exact.end() )
+  {
+    first = it->second;
+  }
+
+  // Map options parse "<name><key>" and "<name><key>+", where the key follows the last dot
+  if ( !_prefix.empty() && !name.empty() )
+  {
+    auto last = name.size() - 1;
+    if ( name[ last ] == '+' )
+    {
+      --last;
+    }
+
+    auto dot = name.rfind( ".", last );
+    if ( dot != util::string_view::npos )
+    {
+      auto prefix_it = _prefix.find( name.substr( 0, dot + 1 ) );
+      if ( prefix_it != _prefix.end() )
+      {
+        first = std::min( first, prefix_it->second );
+      }
+    }
+  }
+
+  // Options before the first match cannot parse the name. Parse the rest of the list in order, so
+  // an option that does not parse the name after all falls through to the next one.
+  return opts::parse( sim, options.subspan( first ), name, value, status_fn );
+}
+
 // option_t::parse ==========================================================
 
 void opts::parse( sim_t*                                      sim,
@@ -45,6 +45,9 @@ public:
   opts::parse_status parse( sim_t* sim, util::string_view name, util::string_view value ) const;
   util::string_view name() const
   { return _name; }
+  // Option parses all names starting with its name ( map options ), instead of just its name
+  virtual bool match_prefix() const
+  { return false; }
   
   friend void format_to( const option_t&, fmt::format_context::iterator );
 protected:
@@ -66,6 +69,28 @@ typedef std::vector<std::string> list_t;
 parse_status parse( sim_t*, util::span<const std::unique_ptr<option_t>>, util::string_view name, util::string_view value, const parse_status_fn_t& fn = nullptr );
 void parse( sim_t*, util::string_view context, util::span<const std::unique_ptr<option_t>>, util::string_view options_str, const parse_status_fn_t& fn = nullptr );
 void parse( sim_t*, util::string_view context, util::span<const std::unique_ptr<option_t>>, util::span<const util::string_view> strings, const parse_status_fn_t& fn = nullptr );
+
+/* Name index of an option list that is parsed many times ( sim and player options )
+ *
+ * Options are found by their name in one hash lookup, and map options by the prefix of the name up to
+ * its last dot, instead of trying every option in turn. Parsing gives the same result as
+ * opts::parse() on the list: the first option in list order that parses the name. The index is
+ * rebuilt whenever options were added to the list.
+ */
+class option_index_t
+{
+  using index_t = std::unordered_map<util::string_view, size_t>;
+
+  const std::unique_ptr<option_t>* _data = nullptr;
+  size_t _size = 0;
+  index_t _exact;
+  index_t _prefix;
+
+  void build( util::span<const std::unique_ptr<option_t>> options );
+
+public:
+  parse_status parse( sim_t*, util::span<const std::unique_ptr<option_t>>, util::string_view name, util::string_view value, const parse_status_fn_t& fn = nullptr );
+};
 }
 
 inline void format_to( const std::unique_ptr<option_t>& option, fmt::format_context::iterator out )
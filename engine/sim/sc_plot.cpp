@@ -10,9 +10,12 @@
 #include "report/reports.hpp"
 #include "sc_sim.hpp"
 #include "scale_factor_control.hpp"
+#include "util/concurrency.hpp"
 #include "util/io.hpp"
+#include "util/plot_data.hpp"
 
 #include <memory>
+#include <vector>
 
 namespace
 {  // UNNAMED NAMESPACE ==========================================
@@ -162,16 +165,23 @@ void plot_t::analyze_stats()
       end   = -start;
     }
 
-    for ( int j = start; j <= end; j++ )
-    {
+    // Plot data of each point, for each player in players_by_name order. Points are simulated by
+    // the delta sim scheduler of scale factors, and added to the players in plot order.
+    std::vector<std::vector<plot_data_t>> point_data( end - start + 1 );
+    mutex_t point_mutex;
+
+    sim->scaling->run_delta_jobs( point_data.size(), [ & ]( size_t idx ) {
       if ( sim->is_canceled() )
-        break;
+        return;
+
+      int j = start + as<int>( idx );
 
       std::unique_ptr<sim_t> delta_sim;
 
       if ( j != 0 )
       {
         delta_sim = std::make_unique<sim_t>( sim );
+        sim->scaling->prepare_delta_sim( delta_sim.get() );
         if ( dps_plot_iterations > 0 )
         {
           delta_sim->work_queue->init( dps_plot_iterations );
@@ -185,18 +195,23 @@ void plot_t::analyze_stats()
         delta_sim->execute();
         if ( dps_plot_debug )
         {
+          AUTO_LOCK( point_mutex );
           sim->out_debug.raw().print( "Stat={} Point={}\n",
                                       util::stat_type_string( i ), j );
           report::print_text( delta_sim.get(), true );
         }
       }
 
-      for ( player_t* p : sim->players_by_name )
+      auto& data_list = point_data[ idx ];
+      data_list.resize( sim->players_by_name.size() );
+
+      for ( size_t k = 0; k < sim->players_by_name.size(); ++k )
       {
+        player_t* p = sim->players_by_name[ k ];
         if ( !p->scaling->scales_with[ i ] )
           continue;
 
-        plot_data_t data;
+        plot_data_t& data = data_list[ k ];
 
         if ( delta_sim )
         {
@@ -216,13 +231,29 @@ void plot_t::analyze_stats()
           data.error = scaling_data.stddev * sim->confidence_estimator;
         }
         data.plot_step = j * dps_plot_step;
-        p->dps_plot_data[ i ].push_back( data );
       }
 
       if ( delta_sim )
       {
+        AUTO_LOCK( point_mutex );
         remaining_plot_points--;
       }
+    } );
+
+    for ( const auto& data_list : point_data )
+    {
+      // Points not simulated due to the sim being canceled
+      if ( data_list.empty() )
+        continue;
+
+      for ( size_t k = 0; k < sim->players_by_name.size(); ++k )
+      {
+        player_t* p = sim->players_by_name[ k ];
+        if ( p->scaling->scales_with[ i ] )
+        {
+          p->dps_plot_data[ i ].push_back( data_list[ k ] );
+        }
+      }
     }
 
     remaining_plot_stats--;
@@ -19,6 +19,7 @@
 
 #include <future>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <sstream>
 
@@ -99,12 +100,28 @@ std::string format_time( double seconds, bool milliseconds = true )
   return s.str();
 }
 
-// Deallocating profile_sim is the responsibility of the caller (i.e., profileset driver or
-// worker_t)
-void simulate_profileset( sim_t* parent, profileset::profile_set_t& set, sim_t*& profile_sim )
+// Metrics where a lower value is the better profileset
+bool lower_is_better( scale_metric_e metric )
+{
+  switch ( metric )
+  {
+    case SCALE_METRIC_DTPS:
+    case SCALE_METRIC_DMG_TAKEN:
+    case SCALE_METRIC_TMI:
+    case SCALE_METRIC_ETMI:
+    case SCALE_METRIC_DEATHS:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Profileset specific sim settings, applied before the profileset sim is initialized
+void prepare_profileset_sim( const sim_t* parent, sim_t* profile_sim )
 {
-  // Reset random seed for the profileset sims
-  profile_sim -> seed = 0;
+  // Reset random seed for the profileset sims, unless they replay the random numbers of the
+  // baseline
+  profile_sim -> seed = parent -> common_random_numbers ? parent -> seed : 0;
   profile_sim -> profileset_enabled = true;
   profile_sim -> report_details = 0;
   if ( parent -> profileset_work_threads > 0 )
@@ -114,18 +131,114 @@ void simulate_profileset( sim_t* parent, profileset::profile_set_t& set, sim_t*&
     // progress. For normal profileset simming we can rely on the normal progressbar updates
     profile_sim -> report_progress = false;
   }
-  else
+}
+
+// Attach a profileset snapshot (a sim initialized without a parent during profileset validation)
+// to the parent sim, mirroring what the sim_t( parent, index, control ) constructor sets up.
+// Ownership passes to the caller.
+sim_t* adopt_snapshot( sim_t* parent, std::unique_ptr<sim_t> snapshot )
+{
+  snapshot -> parent = parent;
+  snapshot -> report_progress = parent -> report_progress;
+  parent -> add_relative( snapshot.get() );
+
+  return snapshot.release();
+}
+
+// Paired differences of the profileset and baseline metric results, over the iterations both
+// simulated with common random numbers. The iterations of the two sims share their random numbers, so
+// the differences carry much less noise than the difference of the independent means.
+void paired_results( const sim_t* parent, const sim_t* profile_sim, profileset::profile_set_t& set )
+{
+  const auto& metrics = parent -> profileset_metric;
+  const size_t n_metrics = metrics.size();
+  if ( parent -> crn_results.size() != parent -> crn_iterations.size() * n_metrics ||
+       profile_sim -> crn_results.size() != profile_sim -> crn_iterations.size() * n_metrics )
+  {
+    return;
+  }
+
+  // Baseline results entry of each iteration
+  std::vector<size_t> baseline_entry;
+  for ( size_t i = 0; i < parent -> crn_iterations.size(); ++i )
+  {
+    auto iteration = parent -> crn_iterations[ i ];
+    if ( iteration >= baseline_entry.size() )
+    {
+      baseline_entry.resize( iteration + 1, parent -> crn_iterations.size() );
+    }
+    baseline_entry[ iteration ] = i;
+  }
+
+  // Running mean and sum of squared deviations of the differences, per metric
+  size_t n = 0;
+  std::vector<double> mean( n_metrics ), m2( n_metrics );
+  for ( size_t i = 0; i < profile_sim -> crn_iterations.size(); ++i )
+  {
+    auto iteration = profile_sim -> crn_iterations[ i ];
+    if ( iteration >= baseline_entry.size() || baseline_entry[ iteration ] == parent -> crn_iterations.size() )
+    {
+      continue;
+    }
+
+    ++n;
+    for ( size_t m = 0; m < n_metrics; ++m )
+    {
+      double delta = profile_sim -> crn_results[ i * n_metrics + m ] -
+                     parent -> crn_results[ baseline_entry[ iteration ] * n_metrics + m ];
+      double d = delta - mean[ m ];
+      mean[ m ] += d / n;
+      m2[ m ] += d * ( delta - mean[ m ] );
+    }
+  }
+
+  if ( n < 2 )
+  {
+    return;
+  }
+
+  for ( size_t m = 0; m < n_metrics; ++m )
+  {
+    set.result( metrics[ m ] )
+      .paired_delta( mean[ m ] )
+      .paired_delta_stddev( std::sqrt( m2[ m ] / ( n - 1 ) / n ) )
+      .paired_iterations( n );
+  }
+}
+
+// Deallocating profile_sim is the responsibility of the caller (i.e., profileset driver or
+// worker_t). A non-zero race_iterations runs a racing screening pass of that many iterations,
+// which keeps the profileset options around for the full run of the surviving profilesets.
+void simulate_profileset( sim_t* parent, profileset::profile_set_t& set, sim_t*& profile_sim,
+                          int race_iterations )
+{
+  prepare_profileset_sim( parent, profile_sim );
+  if ( parent -> profileset_work_threads == 0 )
   {
     profile_sim -> progress_bar.set_base( "Profileset" );
     profile_sim -> progress_bar.set_phase( set.name() );
   }
 
+  // Snapshots come initialized, otherwise initialization is part of the execution
+  bool initialized = profile_sim -> initialized;
+
+  if ( race_iterations > 0 )
+  {
+    profile_sim -> iterations = race_iterations;
+    profile_sim -> target_error = 0;
+    profile_sim -> work_queue -> init( race_iterations );
+  }
+
   auto ret = profile_sim -> execute();
+
+  auto init_time = initialized ? chrono::wall_clock::duration::zero() : profile_sim -> init_time;
+  set.add_time( init_time, profile_sim -> elapsed_time - init_time );
+
   if ( ret )
   {
     profile_sim -> progress_bar.restart();
 
-    if ( set.has_output() )
+    if ( set.has_output() && race_iterations == 0 )
     {
       report::print_suite( profile_sim );
     }
@@ -154,6 +267,11 @@ void simulate_profileset( sim_t* parent, profileset::profile_set_t& set, sim_t*&
       .iterations( progress.current_iterations );
   } );
 
+  if ( parent -> common_random_numbers )
+  {
+    paired_results( parent, profile_sim, set );
+  }
+
   if ( ! parent -> profileset_output_data.empty() )
   {
     const auto parent_player = parent -> player_no_pet_list.data().front();
@@ -166,10 +284,14 @@ void simulate_profileset( sim_t* parent, profileset::profile_set_t& set, sim_t*&
   parent -> elapsed_cpu  += profile_sim -> elapsed_cpu;
   parent -> init_time    += profile_sim -> init_time;
   parent -> merge_time   += profile_sim -> merge_time;
+  parent -> merge_wall_time += profile_sim -> merge_wall_time;
   parent -> analyze_time += profile_sim -> analyze_time;
   parent -> event_mgr.total_events_processed += profile_sim -> event_mgr.total_events_processed;
 
-  set.cleanup_options();
+  if ( race_iterations == 0 )
+  {
+    set.cleanup_options();
+  }
 }
 
 void insert_data( highchart::bar_chart_t& chart,
@@ -388,7 +510,7 @@ sim_control_t* profilesets_t::create_sim_options( const sim_control_t*
 
 profilesets_t::profilesets_t() : m_state( STARTED ), m_mode( SEQUENTIAL ),
     m_original( nullptr ), m_insert_index( -1 ),
-    m_work_index( 0 )
+    m_work_index( 0 ), m_race_iterations( 0 ), m_eliminated( 0 )
 #ifndef SC_NO_THREADING
     ,
     m_control_lock( m_mutex, std::defer_lock ),
@@ -415,10 +537,21 @@ profilesets_t::~profilesets_t()
 }
 
 profile_set_t::profile_set_t( const std::string& name, sim_control_t* opts, bool has_output ) :
-  m_name( name ), m_options( opts ), m_has_output( has_output ), m_output_data( nullptr )
+  m_name( name ), m_options( opts ), m_has_output( has_output ), m_eliminated( false ),
+  m_output_data( nullptr ), m_init_time(), m_simulate_time()
 {
 }
 
+void profile_set_t::snapshot( std::unique_ptr<sim_t> sim )
+{
+  m_snapshot = std::move( sim );
+}
+
+std::unique_ptr<sim_t> profile_set_t::release_snapshot()
+{
+  return std::move( m_snapshot );
+}
+
 sim_control_t* profile_set_t::options() const
 {
   return m_options;
@@ -511,9 +644,16 @@ void worker_t::execute()
 {
   try
   {
-    m_sim = new sim_t( m_parent, 0, m_profileset -> options() );
+    if ( auto snapshot = m_profileset -> release_snapshot() )
+    {
+      m_sim = adopt_snapshot( m_parent, std::move( snapshot ) );
+    }
+    else
+    {
+      m_sim = new sim_t( m_parent, 0, m_profileset -> options() );
+    }
 
-    simulate_profileset( m_parent, *m_profileset, m_sim );
+    simulate_profileset( m_parent, *m_profileset, m_sim, m_master -> race_iterations() );
   }
   catch (const std::exception& e )
   {
@@ -596,15 +736,23 @@ void profilesets_t::generate_work( sim_t* parent, std::unique_ptr<profile_set_t>
 {
   if ( m_mode == SEQUENTIAL )
   {
-    auto original_opts = parent -> control;
+    sim_t* profile_sim = nullptr;
+    if ( auto snapshot = ptr_set -> release_snapshot() )
+    {
+      profile_sim = adopt_snapshot( parent, std::move( snapshot ) );
+    }
+    else
+    {
+      auto original_opts = parent -> control;
 
-    parent -> control = ptr_set -> options();
+      parent -> control = ptr_set -> options();
 
-    sim_t* profile_sim = new sim_t( parent );
+      profile_sim = new sim_t( parent );
 
-    parent -> control = original_opts;
+      parent -> control = original_opts;
+    }
 
-    simulate_profileset( parent, *ptr_set.get(), profile_sim );
+    simulate_profileset( parent, *ptr_set.get(), profile_sim, m_race_iterations );
 
     delete profile_sim;
   }
@@ -640,6 +788,15 @@ bool profilesets_t::validate( sim_t* ps_sim )
     return false;
   }
 
+  // Racing compares confidence intervals of the screening iterations, which need at least two
+  // iterations for a variance
+  if ( ps_sim -> profileset_race_iterations != 0 && ps_sim -> profileset_race_iterations < 2 )
+  {
+    ps_sim -> error( "Profileset racing needs at least 2 screening iterations, profileset_race_iterations={}",
+                     ps_sim -> profileset_race_iterations );
+    return false;
+  }
+
   return true;
 }
 
@@ -658,6 +815,17 @@ bool profilesets_t::parse( sim_t* sim )
 
     m_mutex.lock();
 
+    // Bound the number of initialized snapshots waiting to be simulated
+    if ( sim -> profileset_snapshot )
+    {
+      std::unique_lock<std::mutex> lock( m_mutex, std::adopt_lock );
+      m_snapshot_control.wait( lock, [ this, sim ] {
+        return sim -> canceled || m_state == DONE ||
+               m_profilesets.size() - m_work_index < max_snapshots( sim );
+      } );
+      lock.release();
+    }
+
     if ( m_init_index == sim -> profileset_map.cend() )
     {
       m_mutex.unlock();
@@ -693,13 +861,20 @@ bool profilesets_t::parse( sim_t* sim )
              util::str_compare_ci( name, "json2" );
     } ) != profileset_opts.end();
 
-    // Test that profileset options are OK, up to the simulation initialization
+    // Test that profileset options are OK, up to the simulation initialization. In snapshot mode,
+    // the test sim is initialized with the profileset sim settings and kept for simulation.
+    std::unique_ptr<sim_t> test_sim;
+    auto start_time = chrono::wall_clock::now();
     try
     {
-      std::unique_ptr<sim_t> test_sim = std::make_unique<sim_t>();
+      test_sim = std::make_unique<sim_t>();
       test_sim -> profileset_enabled = true;
 
       test_sim -> setup( control );
+      if ( sim -> profileset_snapshot )
+      {
+        prepare_profileset_sim( sim, test_sim.get() );
+      }
       test_sim -> init();
     }
     catch ( const std::exception& e )
@@ -713,9 +888,19 @@ bool profilesets_t::parse( sim_t* sim )
       return false;
     }
 
+    auto set = std::make_unique<profile_set_t>( profileset_name, control, has_output_opts );
+    set -> add_time( chrono::elapsed( start_time ), chrono::wall_clock::duration::zero() );
+    if ( sim -> profileset_snapshot )
+    {
+      set -> snapshot( std::move( test_sim ) );
+    }
+    else
+    {
+      test_sim.reset();
+    }
+
     m_mutex.lock();
-    m_profilesets.push_back( std::make_unique<profile_set_t>(
-        profileset_name, control, has_output_opts ) );
+    m_profilesets.push_back( std::move( set ) );
     m_control.notify_one();
     m_mutex.unlock();
   }
@@ -799,6 +984,11 @@ void profilesets_t::initialize( sim_t* sim )
 
 void profilesets_t::cancel()
 {
+  // Wake up init threads waiting for snapshot room, the sim is canceled at this point
+  m_mutex.lock();
+  m_mutex.unlock();
+  m_snapshot_control.notify_all();
+
   if ( ! is_done() )
   {
     range::for_each( m_thread, []( std::thread& thread ) {
@@ -819,6 +1009,14 @@ void profilesets_t::set_state( state new_state )
   m_state = new_state;
 
   m_mutex.unlock();
+
+  m_snapshot_control.notify_all();
+}
+
+// Initialized snapshots allowed to wait for simulation, enough to keep all workers busy
+size_t profilesets_t::max_snapshots( const sim_t* sim ) const
+{
+  return std::max( m_max_workers, as<size_t>( 1 ) ) + as<size_t>( sim -> profileset_init_threads );
 }
 
 std::string profilesets_t::current_profileset_name()
@@ -847,6 +1045,9 @@ bool profilesets_t::iterate( sim_t* parent )
 
   m_start_time = chrono::wall_clock::now();
 
+  // With racing enabled, the first pass through the profilesets is the screening pass
+  m_race_iterations = std::max( 0, parent -> profileset_race_iterations );
+
   while ( ! is_done() )
   {
     m_control_lock.lock();
@@ -871,6 +1072,8 @@ bool profilesets_t::iterate( sim_t* parent )
 
     m_control_lock.unlock();
 
+    m_snapshot_control.notify_all();
+
     generate_work( parent, set );
   }
 
@@ -878,6 +1081,40 @@ bool profilesets_t::iterate( sim_t* parent )
   // not need to finalize any work (all work has been done by the loop above)
   finalize_work();
 
+  // Racing: drop the profilesets that are clearly behind, and run the rest with the full budget
+  if ( m_race_iterations > 0 && ! parent -> canceled && ! is_done() )
+  {
+    race( parent );
+
+    m_race_iterations = 0;
+
+    m_control_lock.lock();
+    m_work_index = 0;
+    m_control_lock.unlock();
+
+    while ( ! is_done() && ! parent -> canceled )
+    {
+      m_control_lock.lock();
+
+      if ( m_work_index == m_profilesets.size() )
+      {
+        m_control_lock.unlock();
+        break;
+      }
+
+      auto& set = m_profilesets[ m_work_index++ ];
+
+      m_control_lock.unlock();
+
+      if ( ! set -> eliminated() )
+      {
+        generate_work( parent, set );
+      }
+    }
+
+    finalize_work();
+  }
+
   // Output profileset progressbar whenever we finish anything
   output_progressbar( parent );
 
@@ -891,6 +1128,44 @@ bool profilesets_t::iterate( sim_t* parent )
   return true;
 }
 
+// Sequential confidence interval elimination over the screening results. A profileset whose
+// confidence interval of the primary metric lies entirely behind the interval of the leading
+// profileset cannot realistically catch up, and is not simulated further.
+void profilesets_t::race( sim_t* parent )
+{
+  auto metric = parent -> profileset_metric.front();
+  auto sign = lower_is_better( metric ) ? -1.0 : 1.0;
+
+  auto best_lower_bound = std::numeric_limits<double>::lowest();
+  range::for_each( m_profilesets, [ & ]( const profileset_entry_t& profileset ) {
+    const auto& result = profileset -> result( metric );
+    if ( result.iterations() == 0 )
+    {
+      return;
+    }
+
+    auto lower_bound = sign * result.mean() - parent -> confidence_estimator * result.mean_stddev();
+    best_lower_bound = std::max( best_lower_bound, lower_bound );
+  } );
+
+  m_eliminated = 0;
+  range::for_each( m_profilesets, [ & ]( profileset_entry_t& profileset ) {
+    const auto& result = profileset -> result( metric );
+    if ( result.iterations() == 0 )
+    {
+      return;
+    }
+
+    auto upper_bound = sign * result.mean() + parent -> confidence_estimator * result.mean_stddev();
+    if ( upper_bound < best_lower_bound )
+    {
+      profileset -> eliminate();
+      profileset -> cleanup_options();
+      ++m_eliminated;
+    }
+  } );
+}
+
 void profilesets_t::notify_worker()
 {
   m_work.notify_one();
@@ -981,9 +1256,36 @@ void profilesets_t::output_text( const sim_t& sim, std::ostream& out ) const
   generate_sorted_profilesets( results );
 
   range::for_each( results, [ &out ]( const profile_set_t* profileset ) {
-      fmt::print( out, "    {:-10.3f} : {:s}\n",
-      profileset -> result().median(), profileset -> name().c_str() );
+      const auto& result = profileset -> result();
+      fmt::print( out, "    {:-10.3f} : {:s}{}{}\n",
+      result.median(), profileset -> name().c_str(),
+      result.paired_iterations() > 0
+        ? fmt::format( " (paired delta {:+.3f} +/- {:.3f})", result.paired_delta(), result.paired_delta_stddev() )
+        : "",
+      profileset -> eliminated()
+        ? fmt::format( " (eliminated at {} iterations)", profileset -> result().iterations() )
+        : "" );
   } );
+
+  if ( sim.profileset_race_iterations > 0 )
+  {
+    fmt::print( out, "  Racing eliminated {} of {} profilesets after {} iterations\n",
+      m_eliminated, m_profilesets.size(), sim.profileset_race_iterations );
+  }
+
+  // Only with snapshots, to keep the default text report unchanged
+  if ( sim.profileset_snapshot )
+  {
+    chrono::wall_clock::duration init_time {}, simulate_time {};
+    range::for_each( m_profilesets, [ & ]( const profileset_entry_t& profileset ) {
+      init_time += profileset -> init_time();
+      simulate_time += profileset -> simulate_time();
+    } );
+
+    auto n = as<double>( m_profilesets.size() );
+    fmt::print( out, "  Wall time per profileset: init {:.3f}s, simulate {:.3f}s (snapshot)\n",
+      chrono::to_fp_seconds( init_time ) / n, chrono::to_fp_seconds( simulate_time ) / n );
+  }
 }
 
 void profilesets_t::output_html( const sim_t& sim, std::ostream& out ) const
@@ -1180,6 +1482,8 @@ void create_options( sim_t* sim )
 
   sim -> add_option( opt_int( "profileset_work_threads", sim -> profileset_work_threads ) );
   sim -> add_option( opt_int( "profileset_init_threads", sim -> profileset_init_threads ) );
+  sim -> add_option( opt_int( "profileset_race_iterations", sim -> profileset_race_iterations ) );
+  sim -> add_option( opt_bool( "profileset_snapshot", sim -> profileset_snapshot ) );
 }
 
 statistical_data_t collect( const extended_sample_data_t& c )
@@ -1225,6 +1529,30 @@ statistical_data_t metric_data( const player_t* player, scale_metric_e metric )
   }
 }
 
+// Sum of the per-iteration results collected for the metric
+double metric_sum( const player_t* player, scale_metric_e metric )
+{
+  const auto& d = player -> collected_data;
+
+  switch ( metric )
+  {
+    case SCALE_METRIC_DPS:       return d.dps.sum();
+    case SCALE_METRIC_DPSE:      return d.dpse.sum();
+    case SCALE_METRIC_HPS:       return d.hps.sum();
+    case SCALE_METRIC_HPSE:      return d.hpse.sum();
+    case SCALE_METRIC_APS:       return d.aps.sum();
+    case SCALE_METRIC_DPSP:      return d.prioritydps.sum();
+    case SCALE_METRIC_DTPS:      return d.dtps.sum();
+    case SCALE_METRIC_DMG_TAKEN: return d.dmg_taken.sum();
+    case SCALE_METRIC_HTPS:      return d.htps.sum();
+    case SCALE_METRIC_TMI:       return d.theck_meloree_index.sum();
+    case SCALE_METRIC_ETMI:      return d.effective_theck_meloree_index.sum();
+    case SCALE_METRIC_DEATHS:    return d.deaths.sum();
+    case SCALE_METRIC_HAPS:      return d.hps.sum() + d.aps.sum();
+    default:                     return 0.0;
+  }
+}
+
 void save_output_data( profile_set_t& profileset, const player_t* parent_player, const player_t* player, std::string option )
 {
   // TODO: Make an enum to proper use a switch instead of if/else
@@ -1425,6 +1753,7 @@ namespace profileset
 profile_set_t::~profile_set_t() {}
 void create_options( sim_t* ) {}
 sim_control_t* filter_control( const sim_control_t* ) { return nullptr; }
+double metric_sum( const player_t*, scale_metric_e ) { return 0.0; }
 void profilesets_t::initialize( sim_t* ) {}
 std::string profilesets_t::current_profileset_name() { return "DUMMY"; }
 void profilesets_t::cancel() {}
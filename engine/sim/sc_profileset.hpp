@@ -55,14 +55,20 @@ class profile_result_t
   double         m_stddev;
   double         m_mean_stddev;
   size_t         m_iterations;
+  // Paired difference to the baseline over the iterations both simulated with common random numbers
+  double         m_paired_delta;
+  double         m_paired_delta_stddev;
+  size_t         m_paired_iterations;
 
 public:
   profile_result_t() : m_metric( SCALE_METRIC_NONE ), m_mean( 0 ), m_median( 0 ), m_min( 0 ),
-    m_max( 0 ), m_1stquartile( 0 ), m_3rdquartile( 0 ), m_stddev( 0 ), m_mean_stddev(0), m_iterations( 0 )
+    m_max( 0 ), m_1stquartile( 0 ), m_3rdquartile( 0 ), m_stddev( 0 ), m_mean_stddev(0), m_iterations( 0 ),
+    m_paired_delta( 0 ), m_paired_delta_stddev( 0 ), m_paired_iterations( 0 )
   { }
 
   profile_result_t( scale_metric_e m ) : m_metric( m ), m_mean( 0 ), m_median( 0 ), m_min( 0 ),
-    m_max( 0 ), m_1stquartile( 0 ), m_3rdquartile( 0 ), m_stddev( 0 ), m_mean_stddev(0), m_iterations( 0 )
+    m_max( 0 ), m_1stquartile( 0 ), m_3rdquartile( 0 ), m_stddev( 0 ), m_mean_stddev(0), m_iterations( 0 ),
+    m_paired_delta( 0 ), m_paired_delta_stddev( 0 ), m_paired_iterations( 0 )
   { }
 
   scale_metric_e metric() const
@@ -126,6 +132,24 @@ public:
   profile_result_t& iterations( size_t i )
   { m_iterations = i; return *this; }
 
+  double paired_delta() const
+  { return m_paired_delta; }
+
+  profile_result_t& paired_delta( double v )
+  { m_paired_delta = v; return *this; }
+
+  double paired_delta_stddev() const
+  { return m_paired_delta_stddev; }
+
+  profile_result_t& paired_delta_stddev( double v )
+  { m_paired_delta_stddev = v; return *this; }
+
+  size_t paired_iterations() const
+  { return m_paired_iterations; }
+
+  profile_result_t& paired_iterations( size_t i )
+  { m_paired_iterations = i; return *this; }
+
   statistical_data_t statistical_data() const
   { return { m_min, m_1stquartile, m_median, m_mean, m_3rdquartile, m_max, m_stddev, m_mean_stddev }; }
 };
@@ -380,8 +404,14 @@ class profile_set_t
   std::string                            m_name;
   sim_control_t*                         m_options;
   bool                                   m_has_output;
+  bool                                   m_eliminated;
   std::vector<profile_result_t>          m_results;
   std::unique_ptr<profile_output_data_t> m_output_data;
+  // Sim initialized during validation, kept for simulation with profileset_snapshot=1
+  std::unique_ptr<sim_t>                 m_snapshot;
+  // Wall time spent initializing (including validation), and simulating the profileset
+  chrono::wall_clock::duration           m_init_time;
+  chrono::wall_clock::duration           m_simulate_time;
 
 public:
   profile_set_t( const std::string& name, sim_control_t* opts, bool has_output );
@@ -398,6 +428,26 @@ public:
   bool has_output() const
   { return m_has_output; }
 
+  // Dropped by profileset racing, results are from the screening iterations only
+  bool eliminated() const
+  { return m_eliminated; }
+
+  void eliminate()
+  { m_eliminated = true; }
+
+  void snapshot( std::unique_ptr<sim_t> sim );
+
+  std::unique_ptr<sim_t> release_snapshot();
+
+  chrono::wall_clock::duration init_time() const
+  { return m_init_time; }
+
+  chrono::wall_clock::duration simulate_time() const
+  { return m_simulate_time; }
+
+  void add_time( chrono::wall_clock::duration init, chrono::wall_clock::duration simulate )
+  { m_init_time += init; m_simulate_time += simulate; }
+
   const profile_result_t& result( scale_metric_e metric = SCALE_METRIC_NONE ) const;
 
   profile_result_t& result( scale_metric_e metric );
@@ -472,11 +522,16 @@ private:
   std::unique_ptr<sim_control_t>         m_original;
   int64_t                                m_insert_index;
   size_t                                 m_work_index;
+  // Iterations per profileset in the racing screening pass, 0 outside of it
+  int                                    m_race_iterations;
+  size_t                                 m_eliminated;
 #ifndef SC_NO_THREADING
   std::mutex                             m_mutex;
   std::unique_lock<std::mutex>           m_control_lock;
   std::condition_variable                m_control;
   std::vector<std::thread>               m_thread;
+  // Init threads wait here while enough snapshots are queued for simulation
+  std::condition_variable                m_snapshot_control;
 #endif
 
   // Shared iterator for threaded init workers
@@ -509,10 +564,13 @@ private:
 
   void set_state( state new_state );
 
+  size_t max_snapshots( const sim_t* sim ) const;
+
   size_t n_workers() const;
   void generate_work( sim_t*, std::unique_ptr<profile_set_t>& );
   void cleanup_work();
   void finalize_work();
+  void race( sim_t* parent );
 
   sim_control_t* create_sim_options( const sim_control_t*, const std::vector<std::string>& opts );
 public:
@@ -528,6 +586,12 @@ public:
 
   size_t done_profilesets() const;
 
+  int race_iterations() const
+  { return m_race_iterations; }
+
+  size_t eliminated_profilesets() const
+  { return m_eliminated; }
+
   // Worker sim finished
   void notify_worker();
 
@@ -561,6 +625,7 @@ void create_options( sim_t* sim );
 
 statistical_data_t collect( const extended_sample_data_t& c );
 statistical_data_t metric_data( const player_t* player, scale_metric_e metric );
+double metric_sum( const player_t* player, scale_metric_e metric );
 void save_output_data( profile_set_t& profileset, const player_t* parent_player, const player_t* player, std::string option );
 void fetch_output_data( const profile_output_data_t output_data, js::JsonOutput& ovr );
 
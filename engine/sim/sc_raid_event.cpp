@@ -277,7 +277,7 @@ struct adds_event_t final : public raid_event_t
   void _start() override
   {
     adds_to_remove = static_cast<size_t>(
-        util::round( std::max( 0.0, sim->rng().range( count - count_range, count + count_range ) ) ) );
+        util::round( std::max( 0.0, sim->encounter_rng().range( count - count_range, count + count_range ) ) ) );
 
     double x_offset      = 0;
     double y_offset      = 0;
@@ -302,8 +302,8 @@ struct adds_event_t final : public raid_event_t
         {
           double angle_start = spawn_angle_start * ( m_pi / 180 );
           double angle_end   = spawn_angle_end * ( m_pi / 180 );
-          double angle       = sim->rng().range( angle_start, angle_end );
-          double radius      = sim->rng().range( std::fabs( spawn_radius_min ), std::fabs( spawn_radius_max ) );
+          double angle       = sim->encounter_rng().range( angle_start, angle_end );
+          double radius      = sim->encounter_rng().range( std::fabs( spawn_radius_min ), std::fabs( spawn_radius_max ) );
           x_offset           = radius * cos( angle );
           y_offset           = radius * sin( angle );
           offset_computed    = true;
@@ -712,19 +712,19 @@ struct movement_event_t final : public raid_event_t
     {
       auto min           = static_cast<int>( movement_direction_type::OMNI );
       auto max_exclusive = static_cast<int>( movement_direction_type::RANDOM );
-      m                  = static_cast<movement_direction_type>( int( sim->rng().range( min, max_exclusive ) ) );
+      m                  = static_cast<movement_direction_type>( int( sim->encounter_rng().range( min, max_exclusive ) ) );
     }
 
     if ( distance_range > 0 )
     {
-      move = sim->rng().range( move_distance - distance_range, move_distance + distance_range );
+      move = sim->encounter_rng().range( move_distance - distance_range, move_distance + distance_range );
       if ( move < distance_min )
         move = distance_min;
       else if ( move > distance_max )
         move = distance_max;
     }
     else if ( distance_min > 0 || distance_max > 0 )
-      move = sim->rng().range( distance_min, distance_max );
+      move = sim->encounter_rng().range( distance_min, distance_max );
     else
       move = move_distance;
 
@@ -861,7 +861,7 @@ struct damage_event_t final : public raid_event_t
     for ( auto p : affected_players )
     {
       raid_damage->base_dd_min = raid_damage->base_dd_max =
-          sim->rng().range( amount - amount_range, amount + amount_range );
+          sim->encounter_rng().range( amount - amount_range, amount + amount_range );
       raid_damage->target = p;
       raid_damage->execute();
     }
@@ -925,7 +925,7 @@ struct heal_event_t final : public raid_event_t
       {
         double pct_actual = to_pct;
         if ( to_pct_range > 0 )
-          pct_actual = sim->rng().range( to_pct - to_pct_range, to_pct + to_pct_range );
+          pct_actual = sim->encounter_rng().range( to_pct - to_pct_range, to_pct + to_pct_range );
 
         sim->print_debug( "{} heals {} {}% ({}) of max health, current health {}", *this, p->name(), pct_actual,
                           p->resources.max[ RESOURCE_HEALTH ] * pct_actual / 100,
@@ -936,7 +936,7 @@ struct heal_event_t final : public raid_event_t
       }
       else
       {
-        amount_to_heal = sim->rng().range( amount - amount_range, amount + amount_range );
+        amount_to_heal = sim->encounter_rng().range( amount - amount_range, amount + amount_range );
       }
 
       // heal if there's any healing to be done
@@ -1214,7 +1214,7 @@ timespan_t raid_event_t::cooldown_time()
   }
   else
   {
-    time = sim->rng().gauss( cooldown, cooldown_stddev );
+    time = sim->encounter_rng().gauss( cooldown, cooldown_stddev );
 
     time = clamp( time, cooldown_min, cooldown_max );
   }
@@ -1224,7 +1224,7 @@ timespan_t raid_event_t::cooldown_time()
 
 timespan_t raid_event_t::duration_time()
 {
-  timespan_t time = sim->rng().gauss( duration, duration_stddev );
+  timespan_t time = sim->encounter_rng().gauss( duration, duration_stddev );
 
   time = clamp( time, duration_min, duration_max );
 
@@ -1698,7 +1698,7 @@ bool raid_event_t::filter_player( const player_t* p )
   if ( p->is_pet() && players_only )
     return true;
 
-  if ( !sim->rng().roll( player_chance ) )
+  if ( !sim->encounter_rng().roll( player_chance ) )
     return true;
 
   if ( affected_role != ROLE_NONE && p->role != affected_role )
@@ -0,0 +1,412 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#include "shard.hpp"
+
+#include "action/sc_action.hpp"
+#include "buff/sc_buff.hpp"
+#include "player/action_priority_list.hpp"
+#include "player/sample_data_helper.hpp"
+#include "player/sc_player.hpp"
+#include "player/stats.hpp"
+#include "sim/benefit.hpp"
+#include "sim/gain.hpp"
+#include "sim/iteration_data_entry.hpp"
+#include "sim/proc.hpp"
+#include "sim/sc_sim.hpp"
+#include "sim/uptime.hpp"
+#include "util/archive.hpp"
+#include "util/io.hpp"
+
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace
+{
+using archive_t = util::binary_archive_t;
+
+// Shards are only read by the build that wrote them, bump the version whenever the layout changes
+const char* const SHARD_MAGIC = "simc-shard";
+const uint32_t SHARD_VERSION = 1;
+
+// Writes or reads one object collection, keyed by name. Entries of a shard that have no object in
+// the reading sim ( e.g., dynamically created ones ) are skipped and counted.
+struct transfer_t
+{
+  archive_t& ar;
+  size_t skipped;
+
+  explicit transfer_t( archive_t& a ) : ar( a ), skipped( 0 )
+  { }
+
+  template <typename List, typename Key, typename Fn>
+  void list( const List& objects, Key key, Fn fn )
+  {
+    if ( ! ar.reading() )
+    {
+      uint64_t n = objects.size();
+      ar( n );
+      for ( auto* object : objects )
+      {
+        std::string name = key( *object );
+        ar( name );
+        auto pos = ar.begin_record();
+        fn( *object );
+        ar.end_record( pos );
+      }
+      return;
+    }
+
+    std::unordered_map<std::string, typename List::value_type> index;
+    for ( auto* object : objects )
+    {
+      index.emplace( key( *object ), object );
+    }
+
+    uint64_t n = 0;
+    ar( n );
+    for ( uint64_t i = 0; i < n; ++i )
+    {
+      std::string name;
+      ar( name );
+      auto end = ar.read_record();
+      auto it = index.find( name );
+      if ( it != index.end() )
+      {
+        fn( *it->second );
+        ar.check_record( end );
+      }
+      else
+      {
+        ar.skip_to( end );
+        ++skipped;
+      }
+    }
+  }
+
+  // Vectors sized by the setup, the sizes have to match between the shard and the reading sim
+  template <typename T, typename Fn>
+  void each( std::vector<T>& objects, Fn fn )
+  {
+    uint64_t n = objects.size();
+    ar( n );
+    if ( n != objects.size() )
+    {
+      throw std::runtime_error( "Shard does not match the simulated setup" );
+    }
+
+    for ( auto& object : objects )
+    {
+      fn( object );
+    }
+  }
+
+  void operator()( proc_t& proc )
+  {
+    ar( proc.interval_sum );
+    ar( proc.count );
+  }
+
+  void operator()( gain_t& gain )
+  {
+    ar( gain.actual );
+    ar( gain.overflow );
+    ar( gain.count );
+  }
+
+  void operator()( uptime_t& uptime )
+  {
+    ar( uptime.uptime_sum );
+    ar( uptime.uptime_instance );
+  }
+
+  void operator()( benefit_t& benefit )
+  {
+    ar( benefit.ratio );
+  }
+
+  void operator()( buff_t& buff )
+  {
+    ar( buff.start_intervals );
+    ar( buff.trigger_intervals );
+    ar( buff.duration_lengths );
+    ar( buff.uptime_pct );
+    ar( buff.benefit_pct );
+    ar( buff.trigger_pct );
+    ar( buff.avg_start );
+    ar( buff.avg_refresh );
+    ar( buff.avg_expire );
+    ar( buff.avg_overflow_count );
+    ar( buff.avg_overflow_total );
+    ar( buff.uptime_array );
+    each( buff.stack_uptime, [ this ]( uptime_simple_t& u ) { ar( u.uptime_sum ); } );
+  }
+
+  void operator()( stats_t::stats_results_t& r )
+  {
+    ar( r.actual_amount );
+    ar( r.avg_actual_amount );
+    ar( r.count );
+    ar( r.total_amount );
+    ar( r.fight_actual_amount );
+    ar( r.fight_total_amount );
+    ar( r.overkill_pct );
+  }
+
+  void operator()( stats_t& stats )
+  {
+    ( *this )( stats.resource_gain );
+    ar( stats.num_executes );
+    ar( stats.num_ticks );
+    ar( stats.num_refreshes );
+    ar( stats.num_direct_results );
+    ar( stats.num_tick_results );
+    ar( stats.total_execute_time );
+    ar( stats.total_tick_time );
+    ar( stats.total_amount );
+    ar( stats.actual_amount );
+    ar( stats.portion_aps );
+    ar( stats.portion_apse );
+
+    for ( auto& r : stats.direct_results )
+      ( *this )( r );
+    for ( auto& r : stats.tick_results )
+      ( *this )( r );
+
+    bool has_timeline = stats.timeline_amount != nullptr;
+    ar( has_timeline );
+    if ( has_timeline )
+    {
+      if ( stats.timeline_amount )
+      {
+        ar( *stats.timeline_amount );
+      }
+      else
+      {
+        sc_timeline_t unused;
+        ar( unused );
+      }
+    }
+  }
+
+  void operator()( player_collected_data_t& cd )
+  {
+    ar( cd.total_iterations );
+    ar( cd.fight_length );
+    ar( cd.waiting_time );
+    ar( cd.executed_foreground_actions );
+    ar( cd.dmg );
+    ar( cd.compound_dmg );
+    ar( cd.dps );
+    ar( cd.prioritydps );
+    ar( cd.dtps );
+    ar( cd.dpse );
+    ar( cd.dmg_taken );
+    ar( cd.timeline_dmg );
+    ar( cd.heal );
+    ar( cd.compound_heal );
+    ar( cd.hps );
+    ar( cd.htps );
+    ar( cd.hpse );
+    ar( cd.heal_taken );
+    ar( cd.deaths );
+    ar( cd.timeline_dmg_taken );
+    ar( cd.timeline_healing_taken );
+    ar( cd.theck_meloree_index );
+    ar( cd.effective_theck_meloree_index );
+
+    ar( cd.resource_lost );
+    ar( cd.resource_gained );
+    ar( cd.resource_overflowed );
+    each( cd.resource_timelines, [ this ]( player_collected_data_t::resource_timeline_t& t ) { ar( t.timeline ); } );
+    ar( cd.combat_start_resource );
+    ar( cd.combat_end_resource );
+    each( cd.stat_timelines, [ this ]( player_collected_data_t::stat_timeline_t& t ) { ar( t.timeline ); } );
+
+    ar( cd.health_changes.merged_timeline );
+    ar( cd.health_changes_tmi.merged_timeline );
+  }
+
+  void operator()( player_t& p )
+  {
+    ( *this )( p.collected_data );
+
+    ar( p.iteration_resource_lost );
+    ar( p.iteration_resource_gained );
+    ar( p.iteration_resource_overflowed );
+
+    list( p.buff_list, []( const buff_t& b ) { return fmt::format( "{}/{}", b.name_str, b.source_name() ); },
+          [ this ]( buff_t& b ) { ( *this )( b ); } );
+    list( p.proc_list, []( const proc_t& o ) { return o.name_str; }, [ this ]( proc_t& o ) { ( *this )( o ); } );
+    list( p.gain_list, []( const gain_t& o ) { return o.name_str; }, [ this ]( gain_t& o ) { ( *this )( o ); } );
+    list( p.stats_list, []( const stats_t& o ) { return o.name_str; }, [ this ]( stats_t& o ) { ( *this )( o ); } );
+    list( p.uptime_list, []( const uptime_t& o ) { return o.name_str; }, [ this ]( uptime_t& o ) { ( *this )( o ); } );
+    list( p.benefit_list, []( const benefit_t& o ) { return o.name_str; },
+          [ this ]( benefit_t& o ) { ( *this )( o ); } );
+    list( p.sample_data_list, []( const sample_data_helper_t& o ) { return o.name_str; },
+          [ this ]( sample_data_helper_t& o ) { ar( o ); } );
+
+    list( p.action_priority_list, []( const action_priority_list_t& apl ) { return apl.name_str; },
+          [ this ]( action_priority_list_t& apl ) {
+            ar( apl.condition_evaluations );
+            ar( apl.condition_reuses );
+          } );
+    // Actions are created in the same order for the same setup
+    list( p.action_list, []( const action_t& a ) { return fmt::format( "{}/{}", a.internal_id, a.signature_str ); },
+          [ this ]( action_t& a ) {
+            ar( a.total_executions );
+          } );
+  }
+
+  void operator()( iteration_data_entry_t& entry )
+  {
+    ar( entry.metric );
+    ar( entry.seed );
+    ar( entry.iteration );
+    ar( entry.iteration_length );
+    ar( entry.target_health );
+  }
+
+  void operator()( sim_t& sim )
+  {
+    ar( sim.iterations );
+    ar( sim.simulation_length );
+    ar( sim.total_dmg );
+    ar( sim.raid_dps );
+    ar( sim.total_heal );
+    ar( sim.raid_hps );
+    ar( sim.total_absorb );
+    ar( sim.raid_aps );
+    ar( sim.event_mgr.total_events_processed );
+
+    uint64_t n_iteration_data = sim.iteration_data.size();
+    ar( n_iteration_data );
+    if ( ar.reading() )
+    {
+      sim.iteration_data.clear();
+      for ( uint64_t i = 0; i < n_iteration_data; ++i )
+      {
+        sim.iteration_data.emplace_back( 0.0, 0.0, 0, 0 );
+        ( *this )( sim.iteration_data.back() );
+      }
+    }
+    else
+    {
+      for ( auto& entry : sim.iteration_data )
+        ( *this )( entry );
+    }
+
+    list( sim.buff_list, []( const buff_t& b ) { return b.name_str; }, [ this ]( buff_t& b ) { ( *this )( b ); } );
+    list( sim.actor_list, []( const player_t& p ) { return p.name_str; }, [ this ]( player_t& p ) { ( *this )( p ); } );
+  }
+};
+
+void transfer_header( archive_t& ar, const std::string& path )
+{
+  std::string magic = SHARD_MAGIC;
+  uint32_t version = SHARD_VERSION;
+  ar( magic );
+  ar( version );
+
+  if ( magic != SHARD_MAGIC || version != SHARD_VERSION )
+  {
+    throw std::runtime_error( fmt::format( "'{}' is not a shard file of this version of simc.", path ) );
+  }
+}
+
+std::string read_file( const std::string& path )
+{
+  io::ifstream in;
+  in.open( path, std::ios::in | std::ios::binary );
+  if ( ! in.is_open() )
+  {
+    throw std::runtime_error( fmt::format( "Unable to open shard file '{}'.", path ) );
+  }
+
+  return std::string( std::istreambuf_iterator<char>( in ), std::istreambuf_iterator<char>() );
+}
+
+}  // unnamed namespace
+
+namespace shard
+{
+void write( sim_t& sim, const std::string& path )
+{
+  archive_t ar;
+  transfer_header( ar, path );
+  transfer_t transfer( ar );
+  transfer( sim );
+
+  io::ofstream out;
+  out.open( path, std::ios::out | std::ios::trunc | std::ios::binary );
+  if ( ! out.is_open() )
+  {
+    throw std::runtime_error( fmt::format( "Unable to open shard file '{}'.", path ) );
+  }
+
+  out.write( ar.contents().data(), ar.contents().size() );
+  if ( ! out )
+  {
+    throw std::runtime_error( fmt::format( "Unable to write shard file '{}'.", path ) );
+  }
+
+  std::cout << fmt::format( "Wrote shard of {} iterations to '{}'.\n", sim.iterations, path ) << std::flush;
+}
+
+bool merge( sim_t& sim )
+{
+  try
+  {
+    sim.init();
+  }
+  catch ( const std::exception& )
+  {
+    std::throw_with_nested( std::runtime_error( "Initializing" ) );
+  }
+
+  sim.iterations = 0;
+  size_t skipped = 0;
+
+  // Each shard is read into a sim of the same setup, and merged like the sim of a thread
+  for ( size_t i = 0; i < sim.shard_merge_files.size(); ++i )
+  {
+    const auto& path = sim.shard_merge_files[ i ];
+    try
+    {
+      archive_t ar( read_file( path ) );
+      transfer_header( ar, path );
+
+      auto child = std::make_unique<sim_t>( &sim, as<int>( i ) + 1, sim.control );
+      child->init();
+
+      transfer_t transfer( ar );
+      transfer( *child );
+      if ( ! ar.at_end() )
+      {
+        throw std::runtime_error( "Trailing data" );
+      }
+
+      sim.merge( *child );
+      skipped += transfer.skipped;
+    }
+    catch ( const std::exception& )
+    {
+      std::throw_with_nested( std::runtime_error( fmt::format( "Merging shard '{}'", path ) ) );
+    }
+  }
+
+  std::cout << fmt::format( "Merged {} shards, {} iterations.\n", sim.shard_merge_files.size(), sim.iterations );
+  if ( skipped > 0 )
+  {
+    std::cout << fmt::format( "{} shard entries without a counterpart in this setup were skipped.\n", skipped );
+  }
+  std::cout << std::flush;
+
+  return sim.iterations > 0;
+}
+}  // namespace shard
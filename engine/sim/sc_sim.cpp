@@ -18,6 +18,7 @@
 #include "report/reports.hpp"
 #include "report/sc_highchart.hpp"
 #include "sim/sc_profileset.hpp"
+#include "sim/shard.hpp"
 #include "sim/scale_factor_control.hpp"
 #include "sim/sim_control.hpp"
 #include "sim/sc_option.hpp"
@@ -132,6 +133,8 @@ bool parse_debug_seed( sim_t* sim, util::string_view, util::string_view value )
  * - full_states [bool]: Collects and reports full action and other states, greatly increasing the report size.
  * - pretty_print [bool]: Pretty-print (whitespaces and indentation) the report.
  * - decimal_places [int]: limit floating point decimal places. Valid if > 0
+ * - streaming [bool]: Write the report while walking the sim instead of building the whole document in memory first
+ *   ( default 1 ). The output is identical.
  */
 bool parse_json_reports( sim_t* sim, util::string_view /* option_name */, util::string_view value )
 {
@@ -147,6 +150,7 @@ bool parse_json_reports( sim_t* sim, util::string_view /* option_name */, util::
   bool fullStates = false;
   bool pretty_print = false;
   int decimal_places = 0;
+  bool streaming = true;
   if ( splits.size() > 1 )
   {
     for ( std::size_t i = 1; i < splits.size(); ++i )
@@ -201,6 +205,17 @@ bool parse_json_reports( sim_t* sim, util::string_view /* option_name */, util::
           std::throw_with_nested( std::runtime_error( "Canot parse JSON report option 'decimal places'" ) );
         }
       }
+      if ( splitOptions[ 0 ] == "streaming" )
+      {
+        try
+        {
+          streaming = util::to_int( splitOptions[ 1 ] );
+        }
+        catch ( const std::exception& )
+        {
+          std::throw_with_nested( std::runtime_error( "Canot parse JSON report option 'streaming'" ) );
+        }
+      }
     }
   }
 
@@ -208,6 +223,7 @@ bool parse_json_reports( sim_t* sim, util::string_view /* option_name */, util::
   entry.full_states = fullStates;
   entry.decimal_places = decimal_places;
   entry.pretty_print = pretty_print;
+  entry.streaming = streaming;
 
   sim->json_reports.push_back( std::move( entry ) );
 
@@ -1383,25 +1399,28 @@ struct compare_name
   }
 };
 
+// Collector of the chart data of the HTML report part rendered by the current thread
+thread_local sim_t::report_chart_data_t* report_chart_data = nullptr;
+
 } // UNNAMED NAMESPACE ===================================================
 
 // Standard progress method, normal mode sims use the single (first) index, single actor batch
 // sims progress with the main thread's current index.
 sim_progress_t sim_t::work_queue_t::progress( int idx )
 {
-  G l(m);
   size_t current_index = idx;
   if ( idx < 0 )
   {
     current_index = index;
   }
 
-  if ( current_index >= _total_work.size() )
+  if ( current_index >= _n_entries )
   {
-    return sim_progress_t{ _work.back(), _projected_work.back() };
+    current_index = _n_entries - 1;
   }
 
-  return sim_progress_t{ _work[ current_index ], _projected_work[ current_index ] };
+  const auto& e = _entries[ current_index ];
+  return sim_progress_t{ e.work.load(), e.projected.load() };
 }
 
 // ==========================================================================
@@ -1457,6 +1476,7 @@ sim_t::sim_t() :
   regen_periodicity( timespan_t::from_seconds( 0.25 ) ),
   ignite_sampling_delta( timespan_t::from_seconds( 0.2 ) ),
   fixed_time( true ), optimize_expressions( false ),
+  memoize_conditions( false ), validate_memoized_conditions( false ),
   current_slot( -1 ),
   optimal_raid( 0 ), log( 0 ),
   debug_each( 0 ),
@@ -1487,9 +1507,13 @@ sim_t::sim_t() :
   pvp_crit( false ),
   auto_attacks_always_land( false ),
   active_enemies( 0 ), active_allies( 0 ),
-  _rng(), seed( 0 ), deterministic( 0 ), strict_work_queue( 0 ),
+  _rng(), seed( 0 ), deterministic( 0 ), strict_work_queue( 0 ), vectorized_rng( 0 ),
+  common_random_numbers( 0 ), _encounter_rng(), crn_next_iteration( 0 ), crn_iteration( 0 ),
+  crn_iterations(), crn_results(),
+  shard_index( 0 ), shard_output_str(), shard_merge_files(),
   average_range( true ), average_gauss( false ),
   fight_style(), add_waves( 0 ), overrides( overrides_t() ),
+  buff_registry( std::make_shared<buff_registry_t>() ),
   default_aura_delay( timespan_t::from_millis( 30 ) ),
   default_aura_delay_stddev( timespan_t::from_millis( 5 ) ),
   azerite_status(azerite_control::ENABLED ),
@@ -1503,14 +1527,15 @@ sim_t::sim_t() :
   iteration_dmg( 0 ), priority_iteration_dmg( 0 ), iteration_heal( 0 ), iteration_absorb( 0 ),
   raid_dps(), total_dmg(), raid_hps(), total_heal(), total_absorb(), raid_aps(),
   simulation_length( "Simulation Length", false ),
-  merge_time(), init_time(), analyze_time(),
+  merge_time(), init_time(), analyze_time(), merge_wall_time(),
+  buff_lookups_init( 0 ), buff_lookups_simulation( 0 ), buff_lookups_merge( 0 ),
   report_iteration_data( 0.025 ), min_report_iteration_data( -1 ),
   report_progress( 1 ),
   bloodlust_percent( 25 ), bloodlust_time( timespan_t::from_seconds( 0.5 ) ),
   // Report
   report_precision(2), report_pets_separately( 0 ), report_targets( 1 ), report_details( 1 ), report_raw_abilities( 1 ),
-  report_rng( 0 ), hosted_html( 0 ),
-  save_raid_summary( 0 ), save_gear_comments( 0 ), statistics_level( 1 ), separate_stats_by_actions( 0 ), report_raid_summary( 0 ),
+  report_rng( 0 ), report_stat_cache( 0 ), hosted_html( 0 ),
+  save_raid_summary( 0 ), save_gear_comments( 0 ), statistics_level( 1 ), statistics_sketch( 0 ), separate_stats_by_actions( 0 ), report_raid_summary( 0 ),
   buff_uptime_timeline( 0 ), buff_stack_uptime_timeline( 0 ),
   json_full_states( 0 ),
   decorated_tooltips( -1 ),
@@ -1528,11 +1553,12 @@ sim_t::sim_t() :
   enable_dps_healing( false ),
   scaling_normalized( 1.0 ),
   // Multi-Threading
-  threads( 0 ), thread_index( 0 ), process_priority( computer_process::BELOW_NORMAL ),
+  threads( 0 ), thread_index( 0 ), merge_ready( false ), process_priority( computer_process::BELOW_NORMAL ),
   work_queue( new work_queue_t() ),
   spell_query(), spell_query_level( MAX_LEVEL ),
   pause_mutex( nullptr ),
   paused( false ),
+  html_render_time(),
   chart_show_relative_difference( false ),
   relative_difference_base(),
   chart_boxplot_percentile( .25 ),
@@ -1542,8 +1568,10 @@ sim_t::sim_t() :
   profileset_metric( { SCALE_METRIC_DPS } ),
   profileset_output_data(),
   profileset_enabled( false ),
+  profileset_snapshot( false ),
   profileset_work_threads( 0 ),
-  profileset_init_threads( 1 )
+  profileset_init_threads( 1 ),
+  profileset_race_iterations( 0 )
 {
   item_db_sources.assign( std::begin( default_item_db_sources ),
                           std::end( default_item_db_sources ) );
@@ -1563,6 +1591,8 @@ sim_t::sim_t( sim_t* p, int index ) : sim_t()
 
   parent = p;
   thread_index = index;
+  // Buffs created during setup already need the shared name ids
+  buff_registry = parent -> buff_registry;
 
   // Inherit setup
   setup( parent -> control );
@@ -1590,6 +1620,8 @@ sim_t::sim_t( sim_t* p, int index, sim_control_t* control ) : sim_t()
 
   parent = p;
   thread_index = index;
+  // Buffs created during setup already need the shared name ids
+  buff_registry = parent -> buff_registry;
 
   // Use specialized control for setup
   setup( control );
@@ -1627,6 +1659,12 @@ double sim_t::iteration_time_adjust()
   if ( iterations <= 1 )
     return 1.0;
 
+  // Fight lengths of common random number iterations only depend on the iteration seed
+  if ( common_random_numbers )
+  {
+    return encounter_rng().range( 1.0 - vary_combat_length, 1.0 + vary_combat_length );
+  }
+
   if ( current_iteration == 0 )
     return 1.0;
 
@@ -1750,6 +1788,11 @@ void sim_t::combat()
 {
   if ( debug ) out_debug << "Starting Simulator";
 
+  if ( common_random_numbers )
+  {
+    crn_iteration = ( thread_index > 0 ? parent : this ) -> crn_next_iteration++;
+  }
+
   // The sequencing of event manager seed and flush is very tricky.
   // DO NOT MESS WITH THIS UNLESS YOU ARE EXTREMELY CONFIDENT.
   // combat_begin will seed the event manager with "player_ready" events
@@ -1767,7 +1810,14 @@ void sim_t::reset()
   if ( debug )
     out_debug << "Resetting Simulator";
 
-  if( deterministic )
+  if ( common_random_numbers )
+  {
+    _rng.seed( seed + crn_iteration );
+    _rng.reset();
+    _encounter_rng.seed( ~( seed + crn_iteration ) );
+    _encounter_rng.reset();
+  }
+  else if( deterministic )
     seed = rng().reseed();
 
   event_mgr.reset();
@@ -2005,6 +2055,25 @@ void sim_t::datacollection_end()
     t -> datacollection_end();
   }
 
+  // Record the iteration results of the first actor for common random number comparisons, as the
+  // growth of its collected data over the iteration. Metrics are those of the top-level sim, which
+  // runs the profilesets.
+  const bool crn_record = common_random_numbers && ! single_actor_batch && ! player_no_pet_list.empty();
+  const sim_t* top = this;
+  while ( top -> parent )
+  {
+    top = top -> parent;
+  }
+  const size_t crn_offset = crn_results.size();
+  if ( crn_record )
+  {
+    crn_iterations.push_back( crn_iteration );
+    for ( auto metric : top -> profileset_metric )
+    {
+      crn_results.push_back( -profileset::metric_sum( player_no_pet_list.data().front(), metric ) );
+    }
+  }
+
   if ( single_actor_batch )
   {
     player_no_pet_list[ current_index ] -> datacollection_end();
@@ -2018,6 +2087,14 @@ void sim_t::datacollection_end()
     }
   }
 
+  if ( crn_record )
+  {
+    for ( size_t i = 0; i < top -> profileset_metric.size(); ++i )
+    {
+      crn_results[ crn_offset + i ] += profileset::metric_sum( player_no_pet_list.data().front(), top -> profileset_metric[ i ] );
+    }
+  }
+
   for ( size_t i = 0; i < buff_list.size(); ++i )
   {
     buff_t* b = buff_list[ i ];
@@ -2586,6 +2663,14 @@ void sim_t::init()
       seed  = uint64_t(rd()) | (uint64_t(rd()) << 32);
     }
   }
+  // Shards of a distributed sim draw from disjoint seed ranges. The offset is applied once, by the
+  // top-level sim: thread sims inherit the offset seed from their parent, and profileset sims, which
+  // have no parent but copy the shard options, get it from prepare_profileset_sim().
+  if ( ! parent && ! profileset_enabled && shard_index > 0 )
+  {
+    seed += static_cast<uint64_t>( shard_index ) << 32;
+  }
+  _rng.vectorize( vectorized_rng != 0 );
   _rng.seed( seed + thread_index );
 
   if (   queue_lag_stddev == timespan_t::zero() )   queue_lag_stddev =   queue_lag * 0.25;
@@ -2885,8 +2970,8 @@ bool sim_t::iterate()
     auto old_active = current_index;
     if ( ! canceled )
     {
-      current_index = work_queue -> pop();
-      more_work = work_queue -> more_work();
+      current_index = work_queue -> pop( work_claim );
+      more_work = work_queue -> more_work( work_claim );
 
       if ( more_work && current_index != old_active )
       {
@@ -2904,6 +2989,8 @@ bool sim_t::iterate()
     }
   } while ( more_work && ! canceled );
 
+  work_end_time = chrono::wall_clock::now();
+
   if ( ! canceled && progress_bar.update( true, as<int>(current_index) ) )
   {
     progress_bar.output( true );
@@ -2962,20 +3049,44 @@ void sim_t::set_error(std::string error)
 /// merge sims
 void sim_t::merge( sim_t& other_sim )
 {
-  auto_lock_t auto_lock( merge_mutex );
   const auto start_time = chrono::wall_clock::now();
 
-  if ( scaling -> scale_stat == STAT_NONE &&
-       scaling -> calculate_scale_factors == 0 &&
-       plot -> dps_plot_stat_str.empty() &&
-       reforge_plot -> reforge_plot_stat_str.empty() &&
-       profileset_map.size() == 0 && ! profileset_enabled )
+  // Child sims merge into each other, so decide on the setup of the top-level sim. Children of a
+  // profileset sim do not have its profileset options, and shard merges report on their own.
+  const sim_t* root = this;
+  while ( root -> parent )
   {
-    std::cout << "Merging data from thread-" << other_sim.thread_index << " ..." << std::endl;
+    root = root -> parent;
+  }
+
+  if ( root -> scaling -> scale_stat == STAT_NONE &&
+       root -> scaling -> calculate_scale_factors == 0 &&
+       root -> plot -> dps_plot_stat_str.empty() &&
+       root -> reforge_plot -> reforge_plot_stat_str.empty() &&
+       root -> profileset_map.size() == 0 && ! root -> profileset_enabled &&
+       root -> shard_merge_files.empty() )
+  {
+    // Format the whole line up front, children merge concurrently
+    std::cout << fmt::format( "Merging data from thread-{} ...\n", other_sim.thread_index ) << std::flush;
   }
 
   iterations += other_sim.iterations;
-  work_per_thread[ other_sim.thread_index ] = other_sim.work_done;
+
+  // Per-thread work statistics travel up the merge tree along with the collected data
+  if ( work_per_thread.size() < other_sim.work_per_thread.size() )
+  {
+    work_per_thread.resize( other_sim.work_per_thread.size() );
+    work_end_per_thread.resize( other_sim.work_per_thread.size() );
+  }
+
+  for ( size_t i = 0; i < other_sim.work_per_thread.size(); ++i )
+  {
+    if ( other_sim.work_end_per_thread[ i ] != chrono::wall_clock::time_point{} )
+    {
+      work_per_thread[ i ] = other_sim.work_per_thread[ i ];
+      work_end_per_thread[ i ] = other_sim.work_end_per_thread[ i ];
+    }
+  }
 
   simulation_length.merge( other_sim.simulation_length );
   total_dmg.merge( other_sim.total_dmg );
@@ -2985,24 +3096,40 @@ void sim_t::merge( sim_t& other_sim )
   total_absorb.merge( other_sim.total_absorb );
   raid_aps.merge( other_sim.raid_aps );
   event_mgr.merge( other_sim.event_mgr );
+  buff_lookups_init += other_sim.buff_lookups_init;
+  buff_lookups_simulation += other_sim.buff_lookups_simulation;
+  buff_lookups_merge += other_sim.buff_lookups_merge;
 
-  for ( auto & buff : buff_list )
+  // Both sims share the buff registry, so global buffs are paired by their name id
+  for ( buff_t* buff : buff_list )
   {
-    if ( buff_t* otherbuff = buff_t::find( &other_sim, buff -> name_str.c_str() ) )
+    buff_lookups_merge++;
+    if ( buff_t* otherbuff = other_sim.buff_index.find( buff -> name_id ) )
     {
       buff -> merge( *otherbuff );
     }
   }
 
-  for ( auto & player : actor_list )
+  for ( size_t i = 0; i < actor_list.size(); ++i )
   {
+    player_t* player = actor_list[ i ];
+
     // If the player is spawned by a separate wrapper class, it will handle the merging process
     if ( player -> spawner != nullptr )
     {
       continue;
     }
 
-    player_t* other_p = other_sim.find_player( player -> index );
+    player_t* other_p = nullptr;
+    if ( i < other_sim.actor_list.size() && other_sim.actor_list[ i ] -> index == player -> index )
+    {
+      other_p = other_sim.actor_list[ i ];
+    }
+    else
+    {
+      other_p = other_sim.find_player( player -> index );
+    }
+
     assert( other_p );
     player -> merge( *other_p );
   }
@@ -3014,24 +3141,87 @@ void sim_t::merge( sim_t& other_sim )
   spawner::merge( *this, other_sim );
 
   range::append( iteration_data, other_sim.iteration_data );
-  merge_time += chrono::elapsed(start_time);
+  range::append( crn_iterations, other_sim.crn_iterations );
+  range::append( crn_results, other_sim.crn_results );
+
+  // Merge time of the other sim covers its own subtree of merges
+  merge_time += other_sim.merge_time + chrono::elapsed( start_time );
+}
+
+/// Merge the child sims this sim is responsible for in the merge tree.
+///
+/// Child sims are reduced pairwise: in round k, the sim with thread index t merges the sim with
+/// index t + 2^k if bit k of t is clear, and is itself merged in the round of its lowest set bit.
+/// All merges of a round run concurrently in the threads of the sims, so merging N threads takes
+/// log2(N) rounds instead of N - 1 serialized merges into the main thread.
+void sim_t::merge_children()
+{
+  const auto& all_children = parent ? parent -> children : children;
+  const int n_sims = as<int>( all_children.size() ) + 1;
+
+  auto merge_child = [ this ]( sim_t* child ) {
+    child -> join();
+    if ( child -> merge_ready )
+    {
+      merge( *child );
+    }
+  };
+
+#ifndef SC_NO_THREADING
+  for ( int step = 1; ( thread_index & step ) == 0 && thread_index + step < n_sims; step <<= 1 )
+  {
+    merge_child( all_children[ thread_index + step - 1 ] );
+  }
+#else
+  // Without threading, children run to completion one after another when launched, so the main
+  // thread merges all of them directly.
+  if ( ! parent )
+  {
+    range::for_each( all_children, merge_child );
+  }
+  (void)n_sims;
+#endif
+}
+
+/// Record the work done by this sim in the per-thread statistics
+void sim_t::record_work()
+{
+  if ( work_per_thread.size() <= as<size_t>( thread_index ) )
+  {
+    work_per_thread.resize( thread_index + 1 );
+    work_end_per_thread.resize( thread_index + 1 );
+  }
+
+  work_per_thread[ thread_index ] = work_done;
+  work_end_per_thread[ thread_index ] = work_end_time;
 }
 
 /// merge all sims together
 void sim_t::merge()
 {
-  work_per_thread[ thread_index ] = work_done;
+  record_work();
 
   if ( children.empty() )
     return;
 
-  merge_mutex.unlock();
+  try
+  {
+    merge_children();
+  }
+  catch ( const std::exception& e )
+  {
+    error( "Error merging child simulations: {}", e.what() );
+    cancel();
+  }
+
+  const auto merge_end_time = chrono::wall_clock::now();
 
   for ( size_t i = 0; i < children.size(); i++ )
   {
     sim_t* child = children[ i ];
     if ( child )
     {
+      // Already joined by its parent in the merge tree, this is a no-op
       child -> join();
       children[ i ] = nullptr;
       if ( requires_cleanup() )
@@ -3042,6 +3232,23 @@ void sim_t::merge()
   }
 
   children.clear();
+
+  // Threads that did not finish (e.g., canceled children) have no end time, and are not counted
+  const chrono::wall_clock::time_point no_end_time{};
+  idle_per_thread.resize( work_end_per_thread.size() );
+  auto last_end = *std::max_element( work_end_per_thread.begin(), work_end_per_thread.end() );
+  for ( size_t i = 0; i < work_end_per_thread.size(); ++i )
+  {
+    if ( work_end_per_thread[ i ] != no_end_time )
+    {
+      idle_per_thread[ i ] = last_end - work_end_per_thread[ i ];
+    }
+  }
+
+  if ( last_end != no_end_time && merge_end_time > last_end )
+  {
+    merge_wall_time += merge_end_time - last_end;
+  }
 }
 
 // sim_t::run ===============================================================
@@ -3052,7 +3259,8 @@ void sim_t::run()
   {
     if( iterate() )
     {
-      parent -> merge( *this );
+      record_work();
+      merge_ready = true;
     }
   }
   catch (const std::exception& e )
@@ -3061,6 +3269,19 @@ void sim_t::run()
       parent -> error("Error in child simulation ({}): {}", thread_index, e.what());
     cancel();
   }
+
+  // Merge this sim's subtree, even if it failed itself, so that its children are joined
+  try
+  {
+    merge_children();
+  }
+  catch (const std::exception& e )
+  {
+    if (parent)
+      parent -> error("Error merging child simulation ({}): {}", thread_index, e.what());
+    merge_ready = false;
+    cancel();
+  }
 }
 
 // sim_t::partition =========================================================
@@ -3068,6 +3289,7 @@ void sim_t::run()
 void sim_t::partition()
 {
   iterations = work_queue -> size();
+  crn_next_iteration = 0;
 
   if ( threads <= 1 )
     return;
@@ -3076,8 +3298,6 @@ void sim_t::partition()
 
   thread::set_main_thread_priority();
 
-  merge_mutex.lock(); // parent sim is locked until parent merge() is called
-
   int remainder = iterations % threads;
   iterations /= threads;
 
@@ -3089,6 +3309,10 @@ void sim_t::partition()
   {
     work_queue -> init( iterations );
   }
+  else
+  {
+    work_queue -> share( threads );
+  }
 
   int num_children = threads - 1;
 
@@ -3153,10 +3377,21 @@ bool sim_t::execute()
   bool success = false;
   {
     auto merge_final_action = gsl::finally([&](){ merge(); }); // Always merge, even in cases of unsuccessful simulation!
-    partition();
-    success = iterate();
+    if ( ! parent && ! shard_merge_files.empty() )
+    {
+      success = shard::merge( *this );
+    }
+    else
+    {
+      partition();
+      success = iterate();
+    }
   }
 
+  // Shards hold the merged, but not yet analyzed state
+  if ( success && ! parent && ! shard_output_str.empty() )
+    shard::write( *this, shard_output_str );
+
   if( success )
     analyze();
 
@@ -3237,7 +3472,7 @@ std::unique_ptr<expr_t> sim_t::create_expression( util::string_view name_str )
     return expr_t::create_constant( name_str, target_list.size() );
 
   if ( name_str == "time" )
-    return make_ref_expr( name_str, event_mgr.current_time );
+    return expression::depends_on( make_ref_expr( name_str, event_mgr.current_time ), nullptr, true );
 
   if ( util::str_compare_ci( name_str, "expected_combat_length" ) )
     return make_ref_expr( name_str, expected_iteration_time );
@@ -3440,6 +3675,8 @@ void sim_t::create_options()
   add_option( opt_int( "stat_cache", stat_cache ) );
   add_option( opt_int( "max_aoe_enemies", max_aoe_enemies ) );
   add_option( opt_bool( "optimize_expressions", optimize_expressions ) );
+  add_option( opt_bool( "memoize_conditions", memoize_conditions ) );
+  add_option( opt_bool( "validate_memoized_conditions", validate_memoized_conditions ) );
   add_option( opt_bool( "single_actor_batch", single_actor_batch ) );
   add_option( opt_bool( "progressbar_type", progressbar_type ) );
   add_option( opt_bool( "allow_experimental_specializations", allow_experimental_specializations ) );
@@ -3508,6 +3745,11 @@ void sim_t::create_options()
   add_option( opt_obsoleted( "rng" ) );
   add_option( opt_bool( "deterministic", deterministic ) );
   add_option( opt_bool( "strict_work_queue", strict_work_queue ) );
+  add_option( opt_bool( "vectorized_rng", vectorized_rng ) );
+  add_option( opt_bool( "common_random_numbers", common_random_numbers ) );
+  add_option( opt_int( "shard_index", shard_index, 0, std::numeric_limits<int>::max() ) );
+  add_option( opt_string( "shard_output", shard_output_str ) );
+  add_option( opt_list( "shard_merge", shard_merge_files ) );
   add_option( opt_float( "report_iteration_data", report_iteration_data ) );
   add_option( opt_int( "min_report_iteration_data", min_report_iteration_data ) );
   add_option( opt_bool( "average_range", average_range ) );
@@ -3516,9 +3758,9 @@ void sim_t::create_options()
   add_option( opt_list( "party", party_encoding ) );
   add_option( opt_func( "active", parse_active ) );
   add_option( opt_uint64( "seed", seed ) );
-  add_option( opt_float( "wheel_granularity", event_mgr.wheel_granularity ) );
-  add_option( opt_int( "wheel_seconds", event_mgr.wheel_seconds ) );
-  add_option( opt_int( "wheel_shift", event_mgr.wheel_shift ) );
+  add_option( opt_obsoleted( "wheel_granularity" ) );
+  add_option( opt_obsoleted( "wheel_seconds" ) );
+  add_option( opt_obsoleted( "wheel_shift" ) );
   add_option( opt_string( "reference_player", reference_player_str ) );
   add_option( opt_string( "raid_events", raid_events_str ) );
   add_option( opt_append( "raid_events+", raid_events_str ) );
@@ -3602,7 +3844,9 @@ void sim_t::create_options()
   add_option( opt_bool( "report_details", report_details ) );
   add_option( opt_bool( "report_raw_abilities", report_raw_abilities ) );
   add_option( opt_bool( "report_rng", report_rng ) );
+  add_option( opt_bool( "report_stat_cache", report_stat_cache ) );
   add_option( opt_int( "statistics_level", statistics_level ) );
+  add_option( opt_uint( "statistics_sketch", statistics_sketch ) );
   add_option( opt_bool( "separate_stats_by_actions", separate_stats_by_actions ) );
   add_option( opt_bool( "report_raid_summary", report_raid_summary ) ); // Force reporting of raid summary
   add_option( opt_string( "reforge_plot_output_file", reforge_plot_output_file_str ) );
@@ -3808,7 +4052,7 @@ bool sim_t::parse_option( const std::string& name,
 {
   if ( active_player )
   {
-    auto ret = opts::parse( this, active_player->options, name, value );
+    auto ret = active_player->option_index.parse( this, active_player->options, name, value );
 
     // Bail out early on player-specific option error states
     switch ( ret )
@@ -3823,7 +4067,7 @@ bool sim_t::parse_option( const std::string& name,
     }
   }
 
-  auto ret = opts::parse( this, options, name, value );
+  auto ret = option_index.parse( this, options, name, value );
   // With strict_parsing enabled, anything else than "ok" parse status will result in hard failure
   if ( strict_parsing && ret != opts::parse_status::OK )
   {
@@ -3885,7 +4129,7 @@ void sim_t::setup( sim_control_t* c )
                     o.scope, o.name, o.value));
     }
 
-    auto ret = opts::parse( this, p->options, o.name, o.value );
+    auto ret = p->option_index.parse( this, p->options, o.name, o.value );
     if ( ret == opts::parse_status::FAILURE )
     {
       throw std::invalid_argument(fmt::format("Unable to parse option '{}' with value '{}' for player '{}'.",
@@ -3975,12 +4219,19 @@ void sim_t::setup( sim_control_t* c )
   if ( thread_index == 0 )
   {
     work_per_thread.resize( threads );
+    work_end_per_thread.resize( threads );
+    idle_per_thread.resize( threads );
   }
 
   if( deterministic && ( target_error != 0 ) )
   {
     throw std::invalid_argument("deterministic=1 cannot be used with non-zero target_error values!");
   }
+
+  if ( deterministic && common_random_numbers )
+  {
+    throw std::invalid_argument("deterministic=1 cannot be used with common_random_numbers=1, set a fixed seed instead!");
+  }
 }
 
 // sim_t::progress ==========================================================
@@ -4083,8 +4334,31 @@ void sim_t::abort()
 }
 
 /// add chart to sim for end of report processing
+sim_t::report_chart_scope_t::report_chart_scope_t( report_chart_data_t& data ) : previous( report_chart_data )
+{
+  report_chart_data = &data;
+}
+
+sim_t::report_chart_scope_t::~report_chart_scope_t()
+{
+  report_chart_data = previous;
+}
+
 void sim_t::add_chart_data( const highchart::chart_t& chart )
 {
+  if ( report_chart_data )
+  {
+    if ( chart.toggle_id_str_.empty() )
+    {
+      report_chart_data -> on_ready.push_back( chart.to_aggregate_string( false ) );
+    }
+    else
+    {
+      report_chart_data -> toggled.emplace_back( chart.toggle_id_str_, chart.to_data() );
+    }
+    return;
+  }
+
   if ( chart.toggle_id_str_.empty() )
   {
     on_ready_chart_data.push_back( chart.to_aggregate_string( false ) );
@@ -4095,6 +4369,15 @@ void sim_t::add_chart_data( const highchart::chart_t& chart )
   }
 }
 
+void sim_t::add_chart_data( const report_chart_data_t& data )
+{
+  on_ready_chart_data.insert( on_ready_chart_data.end(), data.on_ready.begin(), data.on_ready.end() );
+  for ( const auto& entry : data.toggled )
+  {
+    chart_data[ entry.first ].push_back( entry.second );
+  }
+}
+
 void sim_t::print_spell_query()
 {
   if ( ! spell_query_xml_output_file_str.empty() )
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "config.hpp"
+#include "buff/buff_registry.hpp"
 #include "event_manager.hpp"
 #include "player/gear_stats.hpp"
 #include "progress_bar.hpp"
@@ -19,6 +20,7 @@
 #include "util/util.hpp"
 #include "util/vector_with_callback.hpp"
 
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <memory>
@@ -116,6 +118,8 @@ struct sim_t : private sc_thread_t
   timespan_t  reaction_time, regen_periodicity;
   timespan_t  ignite_sampling_delta;
   bool        fixed_time, optimize_expressions;
+  // Reuse if expression results while the state they read is unchanged, optionally validated by full evaluation
+  bool        memoize_conditions, validate_memoized_conditions;
   int         current_slot;
   int         optimal_raid, log, debug_each;
   std::vector<uint64_t> debug_seed;
@@ -176,6 +180,7 @@ struct sim_t : private sc_thread_t
   int active_allies;
 
   std::vector<std::unique_ptr<option_t>> options;
+  opts::option_index_t option_index;
   std::vector<std::string> party_encoding;
   std::vector<std::string> item_db_sources;
 
@@ -184,6 +189,22 @@ struct sim_t : private sc_thread_t
   uint64_t seed;
   int deterministic;
   int strict_work_queue;
+  int vectorized_rng;
+  // Common random numbers: iterations are seeded by their sim-wide index instead of the thread RNG,
+  // and fight lengths and raid events draw from a separate encounter RNG. Sims sharing a seed (the
+  // baseline and its profilesets) then replay the same random numbers iteration by iteration.
+  int common_random_numbers;
+  rng::rng_t _encounter_rng;
+  std::atomic<unsigned> crn_next_iteration;
+  unsigned crn_iteration;
+  // Sim-wide index, and the profileset metric results of the first actor, of each simulated iteration
+  std::vector<unsigned> crn_iterations;
+  std::vector<double> crn_results;
+  // Distributed sims: seed offset of this shard, the shard file to write, and the shard files to
+  // merge instead of simulating ( see sim/shard.hpp )
+  int shard_index;
+  std::string shard_output_str;
+  std::vector<std::string> shard_merge_files;
   int average_range, average_gauss;
 
   // Raid Events
@@ -366,6 +387,10 @@ struct sim_t : private sc_thread_t
 
   // Auras and De-Buffs
   auto_dispose<std::vector<buff_t*>> buff_list;
+  buff_index_t buff_index;
+  // Buff name ids, shared with child sims, and the ids of the buffs created in this sim
+  std::shared_ptr<buff_registry_t> buff_registry;
+  buff_names_t buff_names;
 
   // Global aura related delay
   timespan_t default_aura_delay;
@@ -385,10 +410,20 @@ struct sim_t : private sc_thread_t
   chrono::wall_clock::duration elapsed_time;
   std::vector<size_t> work_per_thread;
   size_t work_done;
+  // Wall time each thread spent waiting for the other threads to finish their iterations
+  chrono::wall_clock::time_point work_end_time;
+  std::vector<chrono::wall_clock::time_point> work_end_per_thread;
+  std::vector<chrono::wall_clock::duration> idle_per_thread;
   double     iteration_dmg, priority_iteration_dmg,  iteration_heal, iteration_absorb;
   simple_sample_data_t raid_dps, total_dmg, raid_hps, total_heal, total_absorb, raid_aps;
   extended_sample_data_t simulation_length;
   chrono::wall_clock::duration merge_time, init_time, analyze_time;
+  // Wall time the merge phase added after the last thread finished iterating. Child sims are merged
+  // in a parallel tree, so merge_time (summed over all merges) can exceed it.
+  chrono::wall_clock::duration merge_wall_time;
+  // Buff lookups by name during initialization and simulation ( including reporting ), and buffs
+  // paired by name id while merging
+  uint64_t buff_lookups_init, buff_lookups_simulation, buff_lookups_merge;
   // Deterministic simulation iteration data collectors for specific iteration
   // replayability
   std::vector<iteration_data_entry_t> iteration_data, low_iteration_data, high_iteration_data;
@@ -422,10 +457,13 @@ struct sim_t : private sc_thread_t
   int report_details;
   int report_raw_abilities;
   int report_rng;
+  int report_stat_cache;
   int hosted_html;
   int save_raid_summary;
   int save_gear_comments;
   int statistics_level;
+  // Quantile sketch compression for streamed player statistics, 0 stores every sample
+  unsigned statistics_sketch;
   int separate_stats_by_actions;
   int report_raid_summary;
   int buff_uptime_timeline;
@@ -446,11 +484,14 @@ struct sim_t : private sc_thread_t
   double scaling_normalized;
 
   // Multi-Threading
-  mutex_t merge_mutex;
   int threads;
   std::vector<sim_t*> children; // Manual delete!
   int thread_index;
+  // Set by a child sim when it has data to merge into its merge tree parent
+  bool merge_ready;
   computer_process::priority_e process_priority;
+  // Iteration dispenser. Iterations are handed out lock-free through atomic counters per work
+  // index; the mutex only guards setup and compound updates done through lock()/unlock().
   struct work_queue_t
   {
     private:
@@ -468,65 +509,160 @@ struct sim_t : private sc_thread_t
     no_m m;
     using G = nop;
 #endif
+    struct work_t
+    {
+      std::atomic<int> total { 0 }, work { 0 }, projected { 0 };
+    };
+
+    std::unique_ptr<work_t[]> _entries;
+    size_t _n_entries;
+    // Number of threads sharing the queue, > 1 enables batched claims
+    int _threads;
+    // Incremented on flush, invalidates outstanding claims
+    std::atomic<unsigned> _generation;
+
+    void advance( size_t idx )
+    {
+      if ( idx < _n_entries - 1 )
+      {
+        index.compare_exchange_strong( idx, idx + 1 );
+      }
+    }
+
     public:
-    std::vector<int> _total_work, _work, _projected_work;
-    size_t index;
+    // Iterations claimed in bulk by a single thread that have not been simulated yet
+    struct claim_t
+    {
+      size_t index = 0;
+      int remaining = 0;
+      unsigned generation = 0;
+    };
 
-    work_queue_t() : index( 0 )
-    { _total_work.resize( 1 ); _work.resize( 1 ); _projected_work.resize( 1 ); }
+    std::atomic<size_t> index;
+
+    work_queue_t() : _entries( new work_t[ 1 ] ), _n_entries( 1 ), _threads( 1 ), _generation( 0 ), index( 0 )
+    { }
+
+    void init( int w )
+    {
+      G l(m);
+      for ( size_t i = 0; i < _n_entries; ++i )
+      {
+        _entries[ i ].total = _entries[ i ].projected = w;
+      }
+    }
 
-    void init( int w )    { G l(m); range::fill( _total_work, w ); range::fill( _projected_work, w ); }
     // Single actor batch sim init methods. Batches is the number of active actors
-    void batches( size_t n ) { G l(m); _total_work.resize( n ); _work.resize( n ); _projected_work.resize( n ); }
+    void batches( size_t n )
+    {
+      G l(m);
+      std::unique_ptr<work_t[]> entries( new work_t[ n ] );
+      for ( size_t i = 0; i < std::min( n, _n_entries ); ++i )
+      {
+        entries[ i ].total = _entries[ i ].total.load();
+        entries[ i ].work = _entries[ i ].work.load();
+        entries[ i ].projected = _entries[ i ].projected.load();
+      }
+      _entries = std::move( entries );
+      _n_entries = n;
+    }
+
+    // Allow threads sharing this queue to claim several iterations at once
+    void share( int threads )
+    { _threads = threads; }
+
+    void flush()
+    {
+      auto& e = _entries[ index ];
+      e.total = e.projected = e.work.load();
+      ++_generation;
+    }
+
+    int  size()
+    {
+      size_t idx = index;
+      return idx < _n_entries ? _entries[ idx ].total.load() : _entries[ _n_entries - 1 ].total.load();
+    }
+
+    bool more_work()
+    {
+      size_t idx = index;
+      return idx < _n_entries && _entries[ idx ].work < _entries[ idx ].total;
+    }
+
+    bool more_work( const claim_t& claim )
+    { return ( claim.remaining > 0 && claim.generation == _generation ) || more_work(); }
 
-    void flush()          { G l(m); _total_work[ index ] = _projected_work[ index ] = _work[ index ]; }
-    int  size()           { G l(m); return index < _total_work.size() ? _total_work[ index ] : _total_work.back(); }
-    bool more_work()      { G l(m); return index < _total_work.size() && _work[ index ] < _total_work[ index ]; }
     void lock()           { m.lock(); }
     void unlock()         { m.unlock(); }
 
     void project( int w )
     {
-      G l(m);
-      _projected_work[ index ] = w;
-#ifdef NDEBUG
-      if ( w > _work[ index ] )
-      {
-      }
-#endif
+      _entries[ index ].projected = w;
     }
 
     // Single-actor batch pop, uses several indices of work (per active actor), each thread has it's
     // own state on what index it is simulating
     size_t pop()
     {
-      G l(m);
+      claim_t claim;
+      return pop( claim );
+    }
 
-      if ( _work[ index ] >= _total_work[ index ] )
+    // Account for a finished iteration, and return the work index of the next one. When the queue
+    // is shared, the calling thread claims a batch of iterations sized to the remaining work, so
+    // that the shared counters are touched once per batch instead of once per iteration.
+    size_t pop( claim_t& claim )
+    {
+      if ( claim.remaining > 0 && claim.generation == _generation )
       {
-        if ( index < _work.size() - 1 )
+        if ( --claim.remaining > 0 )
         {
-          ++index;
+          return claim.index;
         }
         return index;
       }
 
-      if ( ++_work[ index ] == _total_work[ index ] )
+      size_t idx = index;
+      auto& e = _entries[ idx ];
+      int w = e.work;
+      int n;
+      do
       {
-        _projected_work[ index ] = _work[ index ];
-        if ( index < _work.size() - 1 )
+        int total = e.total;
+        if ( w >= total )
         {
-          ++index;
+          advance( idx );
+          claim.remaining = 0;
+          return index;
         }
-        return index;
+
+        n = 1;
+        if ( _threads > 1 )
+        {
+          int remaining = std::min( e.projected.load(), total ) - w;
+          n = clamp( remaining / ( _threads * 8 ), 1, 32 );
+          n = std::min( n, total - w );
+        }
+      } while ( !e.work.compare_exchange_weak( w, w + n ) );
+
+      if ( w + n == e.total )
+      {
+        e.projected = w + n;
+        advance( idx );
       }
 
-      return index;
+      claim.index = idx;
+      claim.remaining = n - 1;
+      claim.generation = _generation;
+
+      return claim.remaining > 0 ? idx : index.load();
     }
 
     sim_progress_t progress( int idx = -1 );
   };
   std::shared_ptr<work_queue_t> work_queue;
+  work_queue_t::claim_t work_claim;
 
   // Related Simulations
   mutex_t relatives_mutex;
@@ -550,6 +686,28 @@ struct sim_t : private sc_thread_t
   // to correct elements (toggled elements in the HTML report) based on the data.
   std::map<std::string, std::vector<std::string> > chart_data;
 
+  // Chart data collected while rendering a segment of the HTML report, added to the sim in report
+  // order once the segment is written
+  struct report_chart_data_t
+  {
+    std::vector<std::string> on_ready;
+    std::vector<std::pair<std::string, std::string>> toggled;
+  };
+
+  // Redirects the add_chart_data() calls of the current thread to a collector for the lifetime of
+  // the scope
+  class report_chart_scope_t
+  {
+    report_chart_data_t* previous;
+
+  public:
+    report_chart_scope_t( report_chart_data_t& data );
+    ~report_chart_scope_t();
+  };
+
+  // Wall time spent rendering the actor sections of the HTML report
+  chrono::wall_clock::duration html_render_time;
+
   bool chart_show_relative_difference;
   // Which actor to use as the base for computing relative difference.
   std::string relative_difference_base;
@@ -567,7 +725,8 @@ struct sim_t : private sc_thread_t
   std::vector<scale_metric_e> profileset_metric;
   std::vector<std::string> profileset_output_data;
   bool profileset_enabled;
-  int profileset_work_threads, profileset_init_threads;
+  bool profileset_snapshot;
+  int profileset_work_threads, profileset_init_threads, profileset_race_iterations;
   profileset::profilesets_t profilesets;
 
 
@@ -602,6 +761,8 @@ struct sim_t : private sc_thread_t
   void      analyze();
   void      merge( sim_t& other_sim );
   void      merge();
+  void      merge_children();
+  void      record_work();
   bool      iterate();
   void      partition();
   bool      execute();
@@ -647,6 +808,7 @@ struct sim_t : private sc_thread_t
   void combat_begin();
   void combat_end();
   void add_chart_data( const highchart::chart_t& chart );
+  void add_chart_data( const report_chart_data_t& data );
   bool has_raid_event( util::string_view type ) const;
 
   // Activates the necessary actor/actors before iteration begins.
@@ -662,7 +824,11 @@ struct sim_t : private sc_thread_t
   { return _rng; }
   rng::rng_t& rng()
   { return _rng; }
+  rng::rng_t& encounter_rng()
+  { return common_random_numbers ? _encounter_rng : _rng; }
   double averaged_range( double min, double max );
+  void count_buff_lookup()
+  { ++( initialized ? buff_lookups_simulation : buff_lookups_init ); }
 
   // Thread id of this sim_t object
 #ifndef SC_NO_THREADING
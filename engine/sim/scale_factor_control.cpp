@@ -12,6 +12,8 @@
 #include "report/reports.hpp"
 #include "util/util.hpp"
 
+#include <atomic>
+#include <exception>
 #include <iostream>
 #include <memory>
 
@@ -113,6 +115,20 @@ struct compare_scale_factors
   }
 };
 
+// Worker thread running delta sim jobs
+
+class delta_sim_thread_t : public sc_thread_t
+{
+  std::function<void()> work;
+
+  void run() override
+  { work(); }
+
+public:
+  delta_sim_thread_t( std::function<void()> work ) : work( std::move( work ) )
+  { }
+};
+
 } // UNNAMED NAMESPACE ====================================================
 
 // ==========================================================================
@@ -138,6 +154,9 @@ scale_factor_control_t::scale_factor_control_t( sim_t* s ) :
   num_scaling_stats( 0 ),
   remaining_scaling_stats( 0 ),
   scale_over(), scaling_metric( SCALE_METRIC_DPS ), scale_over_player(),
+  scale_work_threads( 0 ),
+  active_sims(),
+  stat_time(),
   stats(new gear_stats_t())
 {
   create_options();
@@ -171,11 +190,10 @@ double scale_factor_control_t::progress( std::string& phase, std::string* detail
 
   double divisor = num_scaling_stats * 2.0;
 
-  if ( ref_sim  ) stat_progress += divisor * ref_sim  -> progress().pct();
-  if ( ref_sim2 ) stat_progress += divisor * ref_sim2 -> progress().pct();
-
-  if ( delta_sim  ) stat_progress += divisor * delta_sim  -> progress().pct();
-  if ( delta_sim2 ) stat_progress += divisor * delta_sim2 -> progress().pct();
+  for ( sim_t* active_sim : active_sims )
+  {
+    stat_progress += active_sim -> progress().pct() / divisor;
+  }
 
   return stat_progress;
 }
@@ -241,122 +259,222 @@ void scale_factor_control_t::analyze_stats()
   baseline_sim = sim; // Take the current sim as baseline
   mutex.unlock();
 
-  for ( size_t k = 0; k < stats_to_scale.size(); ++k )
-  {
-    if ( sim -> is_canceled() ) break;
+  run_delta_jobs( stats_to_scale.size(), [ this, &stats_to_scale ]( size_t k ) {
+    analyze_stat( stats_to_scale[ k ] );
+  } );
+
+  if ( baseline_sim != sim ) delete baseline_sim;
+  baseline_sim = nullptr;
+}
 
-    current_scaling_stat = stats_to_scale[ k ]; // Stat we're scaling over
-    const stat_e& stat = current_scaling_stat;
+// scaling_t::analyze_stat ==================================================
 
-    double scale_delta = stats->get_stat( stat );
-    assert ( scale_delta );
+void scale_factor_control_t::analyze_stat( stat_e stat )
+{
+  if ( sim -> is_canceled() ) return;
 
-    bool center = center_scale_delta && ! stat_may_cap( stat );
+  const auto start_time = chrono::wall_clock::now();
 
-    mutex.lock();
-    ref_sim = baseline_sim;
-    delta_sim = new sim_t( sim );
-    mutex.unlock();
+  double scale_delta = stats->get_stat( stat );
+  assert ( scale_delta );
 
-    delta_sim -> progress_bar.set_base( util::stat_type_abbrev( stat ) );
+  bool center = center_scale_delta && ! stat_may_cap( stat );
 
-    delta_sim -> scaling -> scale_stat = stat;
-    delta_sim -> scaling -> scale_value = +scale_delta / ( center ? 2 : 1 );
-    delta_sim -> execute();
+  mutex.lock();
+  current_scaling_stat = stat; // Stat we're scaling over
+  mutex.unlock();
 
-    if ( center )
-    {
-      mutex.lock();
-      ref_sim = new sim_t( sim );
-      mutex.unlock();
+  auto delta = create_delta_sim( stat, +scale_delta / ( center ? 2 : 1 ), util::stat_type_abbrev( stat ) );
+  execute_delta_sim( delta.get() );
 
-      ref_sim -> progress_bar.set_base( std::string( "Ref " ) + util::stat_type_abbrev( stat ) );
+  std::unique_ptr<sim_t> center_ref;
+  if ( center )
+  {
+    center_ref = create_delta_sim( stat, -( scale_delta / 2 ), std::string( "Ref " ) + util::stat_type_abbrev( stat ) );
+    execute_delta_sim( center_ref.get() );
+  }
 
-      ref_sim -> scaling -> scale_stat = stat;
-      ref_sim -> scaling -> scale_value = center ? -( scale_delta / 2 ) : 0;
-      ref_sim -> execute();
-    }
+  sim_t* ref = center ? center_ref.get() : baseline_sim;
 
-    for ( size_t j = 0; j < sim -> players_by_name.size(); j++ )
+  // Stats are analyzed one at a time, as the ability scaling data of the players is shared
+  AUTO_LOCK( mutex );
+
+  for ( size_t j = 0; j < sim -> players_by_name.size(); j++ )
+  {
+    player_t* p = sim -> players_by_name[ j ];
+
+    if ( ! p -> scaling -> scales_with[ stat ] ) continue;
+
+    player_t*   ref_p =   ref -> find_player( p -> name() );
+    player_t* delta_p = delta -> find_player( p -> name() );
+    assert( ref_p && "Reference Player not found" );
+    assert( delta_p && "Delta player not found" );
+
+    double divisor = scale_delta;
+
+    if ( delta_p -> invert_scaling )
+      divisor = -divisor;
+
+    if ( divisor < 0.0 ) divisor += ref_p -> scaling -> over_cap[ stat ];
+
+    for ( scale_metric_e sm = SCALE_METRIC_NONE; sm < SCALE_METRIC_MAX; sm++ )
     {
-      player_t* p = sim -> players_by_name[ j ];
 
-      if ( ! p -> scaling -> scales_with[ stat ] ) continue;
+      double delta_score = delta_p -> scaling_for_metric( sm ).value;
+      double   ref_score = ref_p -> scaling_for_metric( sm ).value;
 
-      player_t*   ref_p =   ref_sim -> find_player( p -> name() );
-      player_t* delta_p = delta_sim -> find_player( p -> name() );
-      assert( ref_p && "Reference Player not found" );
-      assert( delta_p && "Delta player not found" );
+      double delta_error = delta_p -> scaling_for_metric( sm ).stddev * delta -> confidence_estimator;
+      double   ref_error = ref_p -> scaling_for_metric( sm ).stddev * ref -> confidence_estimator;
 
-      double divisor = scale_delta;
+      // TODO: this is the only place in the entire code base where scaling_delta_dps shows up, 
+      // apart from declaration in simulationcraft.hpp line 4535. Possible to remove?
+      p -> scaling -> scaling_delta_dps[ sm ].set_stat( stat, delta_score );
 
-      if ( delta_p -> invert_scaling )
-        divisor = -divisor;
+      double score = ( delta_score - ref_score ) / divisor;
+      double error = delta_error * delta_error + ref_error * ref_error;
 
-      if ( divisor < 0.0 ) divisor += ref_p -> scaling -> over_cap[ stat ];
+      if ( error > 0 )
+        error = sqrt( error );
 
-      for ( scale_metric_e sm = SCALE_METRIC_NONE; sm < SCALE_METRIC_MAX; sm++ )
+      error = fabs( error / divisor );
+
+      if ( fabs( divisor ) < 1.0 ) // For things like Weapon Speed, show the gain per 0.1 speed gain rather than every 1.0.
       {
+        score /= 10.0;
+        error /= 10.0;
+        delta_error /= 10.0;
+      }
 
-        double delta_score = delta_p -> scaling_for_metric( sm ).value;
-        double   ref_score = ref_p -> scaling_for_metric( sm ).value;
+      analyze_ability_stats( stat, divisor, p, ref_p, delta_p );
 
-        double delta_error = delta_p -> scaling_for_metric( sm ).stddev * delta_sim -> confidence_estimator;
-        double   ref_error = ref_p -> scaling_for_metric( sm ).stddev * ref_sim -> confidence_estimator;
+      if ( center )
+        p -> scaling -> scaling_compare_error[ sm ].set_stat( stat, error );
+      else
+        p -> scaling -> scaling_compare_error[ sm ].set_stat( stat, delta_error / divisor );
 
-        // TODO: this is the only place in the entire code base where scaling_delta_dps shows up, 
-        // apart from declaration in simulationcraft.hpp line 4535. Possible to remove?
-        p -> scaling -> scaling_delta_dps[ sm ].set_stat( stat, delta_score );
+      p -> scaling -> scaling[ sm ].set_stat( stat, score );
+      p -> scaling -> scaling_error[ sm ].set_stat( stat, error );
+    }
+  }
 
-        double score = ( delta_score - ref_score ) / divisor;
-        double error = delta_error * delta_error + ref_error * ref_error;
+  if ( debug_scale_factors )
+  {
+    std::cout << "\nref_sim report for '" << util::stat_type_string( stat ) << "'..." << std::endl;
+    report::print_text( ref, true );
+    std::cout << "\ndelta_sim report for '" << util::stat_type_string( stat ) << "'..." << std::endl;
+    report::print_text( delta.get(), true );
+  }
 
-        if ( error > 0 )
-          error = sqrt( error );
+  stat_time[ stat ] = chrono::elapsed( start_time );
+  remaining_scaling_stats--;
 
-        error = fabs( error / divisor );
+  // Concurrent delta sims do not print progress bars, report each finished stat instead
+  if ( scale_work_threads > 0 && sim -> report_progress )
+  {
+    fmt::print( "Generating scale factors: {} done in {:.3f} seconds ({}/{})\n", util::stat_type_abbrev( stat ),
+                chrono::to_fp_seconds( stat_time[ stat ] ), num_scaling_stats - remaining_scaling_stats,
+                num_scaling_stats );
+    fflush( stdout );
+  }
+}
 
-        if ( fabs( divisor ) < 1.0 ) // For things like Weapon Speed, show the gain per 0.1 speed gain rather than every 1.0.
-        {
-          score /= 10.0;
-          error /= 10.0;
-          delta_error /= 10.0;
-        }
+// scaling_t::create_delta_sim ==============================================
 
-        analyze_ability_stats( stat, divisor, p, ref_p, delta_p );
+std::unique_ptr<sim_t> scale_factor_control_t::create_delta_sim( stat_e stat, double value, const std::string& name )
+{
+  auto delta = std::make_unique<sim_t>( sim );
+  prepare_delta_sim( delta.get() );
 
-        if ( center )
-          p -> scaling -> scaling_compare_error[ sm ].set_stat( stat, error );
-        else
-          p -> scaling -> scaling_compare_error[ sm ].set_stat( stat, delta_error / divisor );
+  delta -> progress_bar.set_base( name );
+  delta -> scaling -> scale_stat = stat;
+  delta -> scaling -> scale_value = value;
 
-        p -> scaling -> scaling[ sm ].set_stat( stat, score );
-        p -> scaling -> scaling_error[ sm ].set_stat( stat, error );
-      }
-    }
+  return delta;
+}
+
+// scaling_t::prepare_delta_sim =============================================
+
+// Delta sims run concurrently get scale_work_threads threads each, and report progress as they
+// finish instead of through their progress bars.
+void scale_factor_control_t::prepare_delta_sim( sim_t* delta ) const
+{
+  if ( scale_work_threads > 0 )
+  {
+    delta -> threads = scale_work_threads;
+    delta -> report_progress = false;
+  }
+}
+
+// scaling_t::execute_delta_sim =============================================
+
+void scale_factor_control_t::execute_delta_sim( sim_t* delta )
+{
+  mutex.lock();
+  active_sims.push_back( delta );
+  mutex.unlock();
+
+  delta -> execute();
 
-    if ( debug_scale_factors )
+  AUTO_LOCK( mutex );
+  active_sims.erase( range::find( active_sims, delta ) );
+}
+
+// scaling_t::run_delta_jobs ================================================
+
+// Run the delta sim jobs on sim -> threads / scale_work_threads workers, the calling thread being
+// one of them. Without scale_work_threads the jobs run one after another on the calling thread,
+// each delta sim using all sim threads.
+void scale_factor_control_t::run_delta_jobs( size_t n_jobs, const std::function<void( size_t )>& job )
+{
+  size_t n_workers = 1;
+  if ( scale_work_threads > 0 )
+  {
+    n_workers = as<size_t>( sim -> threads / scale_work_threads );
+    if ( n_workers == 0 )
     {
-      std::cout << "\nref_sim report for '" << util::stat_type_string( stat ) << "'..." << std::endl;
-      report::print_text( ref_sim, true );
-      std::cout << "\ndelta_sim report for '" << util::stat_type_string( stat ) << "'..." << std::endl;
-      report::print_text( delta_sim, true );
+      sim -> errorf( "More scale factor work threads defined than simulator threads, reverting to sequential behavior" );
+      scale_work_threads = 0;
+      n_workers = 1;
     }
+  }
 
-    mutex.lock();
-    if ( ref_sim != baseline_sim && ref_sim != sim )
+  std::atomic<size_t> next_job( 0 );
+  std::exception_ptr error;
+  mutex_t error_mutex;
+  auto work = [ & ]() {
+    for ( size_t i = next_job++; i < n_jobs; i = next_job++ )
     {
-      delete ref_sim;
-      ref_sim = nullptr;
+      try
+      {
+        job( i );
+      }
+      catch ( ... )
+      {
+        AUTO_LOCK( error_mutex );
+        if ( ! error )
+        {
+          error = std::current_exception();
+        }
+        next_job = n_jobs;
+      }
     }
-    delete delta_sim;  
-    delta_sim  = nullptr;
-    remaining_scaling_stats--;
-    mutex.unlock();
+  };
+
+  std::vector<std::unique_ptr<delta_sim_thread_t>> threads;
+  for ( size_t i = 1; i < std::min( n_workers, n_jobs ); ++i )
+  {
+    threads.push_back( std::make_unique<delta_sim_thread_t>( work ) );
+    threads.back() -> launch();
   }
 
-  if ( baseline_sim != sim ) delete baseline_sim;
-  baseline_sim = nullptr;
+  work();
+
+  range::for_each( threads, []( std::unique_ptr<delta_sim_thread_t>& thread ) { thread -> join(); } );
+
+  if ( error )
+  {
+    std::rethrow_exception( error );
+  }
 }
 
 /* Creates scale factors for stats_t objects
@@ -546,6 +664,7 @@ void scale_factor_control_t::create_options()
   sim->add_option(opt_string("scale_only", scale_only_str));
   sim->add_option(opt_string("scale_over", scale_over));
   sim->add_option(opt_string("scale_over_player", scale_over_player));
+  sim->add_option(opt_int("scale_work_threads", scale_work_threads));
 }
 
 // scaling_t::has_scale_factors =============================================
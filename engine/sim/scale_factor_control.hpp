@@ -7,9 +7,13 @@
 
 #include "config.hpp"
 #include "sc_enums.hpp"
+#include "util/chrono.hpp"
 #include "util/concurrency.hpp"
+#include <array>
+#include <functional>
 #include <string>
 #include <memory>
+#include <vector>
 
 struct gear_stats_t;
 struct player_t;
@@ -40,6 +44,13 @@ struct scale_factor_control_t
   std::string scale_over;
   scale_metric_e scaling_metric;
   std::string scale_over_player;
+  int    scale_work_threads;
+
+  // Delta sims currently executing, for progress reporting
+  std::vector<sim_t*> active_sims;
+
+  // Wall time spent on the delta sims of each scaled stat
+  std::array<chrono::wall_clock::duration, STAT_MAX> stat_time;
 
   // Gear delta for determining scale factors
   std::unique_ptr<gear_stats_t> stats;
@@ -49,10 +60,15 @@ struct scale_factor_control_t
   void init_deltas();
   void analyze();
   void analyze_stats();
+  void analyze_stat( stat_e );
   void analyze_ability_stats( stat_e, double, player_t*, player_t*, player_t* );
   void analyze_lag();
   void normalize();
   double progress( std::string& phase, std::string* detailed = nullptr );
   void create_options();
   bool has_scale_factors();
+  std::unique_ptr<sim_t> create_delta_sim( stat_e, double, const std::string& );
+  void prepare_delta_sim( sim_t* ) const;
+  void execute_delta_sim( sim_t* );
+  void run_delta_jobs( size_t, const std::function<void( size_t )>& );
 };
\ No newline at end of file
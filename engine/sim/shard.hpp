@@ -0,0 +1,29 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#pragma once
+
+#include "config.hpp"
+
+#include <string>
+
+struct sim_t;
+
+/* Distributed simulation through result shards
+ *
+ * A shard is the mergeable state of a simulation ( sample data, timelines, stats, buffs, procs and
+ * iteration data ) after its threads are merged, but before it is analyzed. Shards of the same
+ * setup simulated on separate machines ( shard_output=, with distinct seeds or shard_index= ) are
+ * combined into one report by a sim reading them instead of simulating ( shard_merge= ).
+ */
+namespace shard
+{
+// Write the mergeable state of a simulated sim to a shard file
+void write( sim_t& sim, const std::string& path );
+
+// Initialize the sim, and merge the shard files given to it instead of simulating. Returns true if
+// any iterations were merged.
+bool merge( sim_t& sim );
+}  // namespace shard
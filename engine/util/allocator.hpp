@@ -68,12 +68,8 @@ public:
     return p;
   }
 
-private:
-  struct page_t {
-    alignas(PageAlignment) char data[PageSize];
-    page_t() noexcept {}
-  };
-
+  // Raw allocation of size bytes at the given alignment. Alignments stricter than
+  // the page alignment are honored by skipping bytes at the current position.
   void* allocate(size_t size, size_t alignment) {
     assert(fits_in_page(size, alignment) && "The allocation does not fit in a single page");
 
@@ -85,6 +81,12 @@ private:
     return finalize_allocation(size);
   }
 
+private:
+  struct page_t {
+    alignas(PageAlignment) char data[PageSize];
+    page_t() noexcept {}
+  };
+
   void* finalize_allocation(size_t size) {
     void* result = current_;
     current_ = static_cast<char*>(current_) + size;
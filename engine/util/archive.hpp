@@ -0,0 +1,193 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#ifndef SC_UTIL_ARCHIVE_HPP
+#define SC_UTIL_ARCHIVE_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace util
+{
+/* Binary archive of mergeable sim results
+ *
+ * The same serialize() functions write values to the archive, or read them back into their
+ * objects, depending on the direction of the archive. Values are stored in their native
+ * representation, so archives are only meant to be read by the same build that wrote them.
+ * Records are length prefixed, so readers can skip records they have no object for.
+ */
+class binary_archive_t
+{
+public:
+  enum direction_e
+  {
+    WRITE,
+    READ
+  };
+
+private:
+  direction_e _direction;
+  std::string _buffer;
+  size_t _pos;
+
+  void write_bytes( const void* data, size_t size )
+  { _buffer.append( static_cast<const char*>( data ), size ); }
+
+  void read_bytes( void* data, size_t size )
+  {
+    if ( size > _buffer.size() - _pos )
+    {
+      throw std::runtime_error( "Truncated archive" );
+    }
+
+    if ( size > 0 )
+    {
+      std::memcpy( data, _buffer.data() + _pos, size );
+    }
+    _pos += size;
+  }
+
+  template <typename T>
+  void transfer_bytes( T* data, size_t n )
+  {
+    if ( _direction == WRITE )
+      write_bytes( data, n * sizeof( T ) );
+    else
+      read_bytes( data, n * sizeof( T ) );
+  }
+
+  template <typename T>
+  void transfer_vector( std::vector<T>& v, std::true_type /* trivially copyable */ )
+  {
+    transfer_bytes( v.data(), v.size() );
+  }
+
+  template <typename T>
+  void transfer_vector( std::vector<T>& v, std::false_type )
+  {
+    for ( auto& entry : v )
+    {
+      ( *this )( entry );
+    }
+  }
+
+public:
+  // An archive to write to
+  binary_archive_t() : _direction( WRITE ), _buffer(), _pos( 0 )
+  { }
+
+  // An archive to read the given contents from
+  explicit binary_archive_t( std::string contents ) : _direction( READ ), _buffer( std::move( contents ) ), _pos( 0 )
+  { }
+
+  bool reading() const
+  { return _direction == READ; }
+
+  bool at_end() const
+  { return _pos == _buffer.size(); }
+
+  const std::string& contents() const
+  { return _buffer; }
+
+  template <typename T>
+  typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value>::type operator()( T& v )
+  { transfer_bytes( &v, 1 ); }
+
+  template <typename T>
+  auto operator()( T& v ) -> decltype( v.serialize( *this ) )
+  { v.serialize( *this ); }
+
+  void operator()( std::string& v )
+  {
+    uint64_t size = v.size();
+    ( *this )( size );
+    if ( reading() )
+    {
+      if ( size > _buffer.size() - _pos )
+      {
+        throw std::runtime_error( "Truncated archive" );
+      }
+      v.assign( _buffer, _pos, size );
+      _pos += size;
+    }
+    else
+    {
+      write_bytes( v.data(), v.size() );
+    }
+  }
+
+  template <typename T>
+  void operator()( std::vector<T>& v )
+  {
+    uint64_t size = v.size();
+    ( *this )( size );
+    if ( reading() )
+    {
+      if ( std::is_trivially_copyable<T>::value && size * sizeof( T ) > _buffer.size() - _pos )
+      {
+        throw std::runtime_error( "Truncated archive" );
+      }
+      v.resize( size );
+    }
+    transfer_vector( v, std::is_trivially_copyable<T>() );
+  }
+
+  template <typename T, size_t N>
+  void operator()( std::array<T, N>& v )
+  {
+    for ( auto& entry : v )
+    {
+      ( *this )( entry );
+    }
+  }
+
+  // Start a length prefixed record when writing. Returns the position to pass to end_record().
+  size_t begin_record()
+  {
+    uint64_t size = 0;
+    size_t pos = _buffer.size();
+    write_bytes( &size, sizeof( size ) );
+    return pos;
+  }
+
+  void end_record( size_t pos )
+  {
+    uint64_t size = _buffer.size() - pos - sizeof( size );
+    std::memcpy( &_buffer[ pos ], &size, sizeof( size ) );
+  }
+
+  // Read the length prefix of a record. Returns the position the record ends at.
+  size_t read_record()
+  {
+    uint64_t size = 0;
+    read_bytes( &size, sizeof( size ) );
+    if ( size > _buffer.size() - _pos )
+    {
+      throw std::runtime_error( "Truncated archive" );
+    }
+    return _pos + size;
+  }
+
+  void skip_to( size_t pos )
+  { _pos = pos; }
+
+  // Verify a record was read completely
+  void check_record( size_t pos ) const
+  {
+    if ( _pos != pos )
+    {
+      throw std::runtime_error( "Archive record does not match its object" );
+    }
+  }
+};
+
+}  // namespace util
+
+#endif  // SC_UTIL_ARCHIVE_HPP
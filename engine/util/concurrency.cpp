@@ -5,7 +5,10 @@
 
 #include "concurrency.hpp"
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <iostream>
 #include <memory>
 #include <mutex>
@@ -37,10 +40,89 @@ public:
   { return m.native_handle(); }
 };
 
+namespace {
+
+std::atomic<bool> reuse_threads_enabled { false };
+
+/* Process-wide set of parked worker threads, used instead of a fresh
+ * std::thread per launch when thread reuse is enabled. A launched task is
+ * handed to an idle worker; if every worker is busy a new one is spawned, so
+ * a task never waits in line behind another task that may be joining it.
+ * The pool is intentionally leaked so that parked workers never outlive it.
+ */
+class thread_pool_t
+{
+public:
+  struct task_t
+  {
+    void ( *entry )( sc_thread_t* ) = nullptr;
+    sc_thread_t* thread = nullptr;
+    std::thread::id id;
+    bool done = true;
+  };
+
+private:
+  std::mutex m;
+  std::condition_variable work_cv;
+  std::condition_variable done_cv;
+  std::deque<task_t*> queue;
+  size_t idle = 0;
+
+  void work()
+  {
+    std::unique_lock<std::mutex> lock( m );
+    while ( true )
+    {
+      work_cv.wait( lock, [ this ] { return !queue.empty(); } );
+      task_t* task = queue.front();
+      queue.pop_front();
+      --idle;
+      task -> id = std::this_thread::get_id();
+      lock.unlock();
+
+      task -> entry( task -> thread );
+
+      lock.lock();
+      task -> done = true;
+      ++idle;
+      done_cv.notify_all();
+    }
+  }
+
+public:
+  static thread_pool_t& instance()
+  {
+    static thread_pool_t* pool = new thread_pool_t();
+    return *pool;
+  }
+
+  void submit( task_t& task )
+  {
+    std::lock_guard<std::mutex> lock( m );
+    task.done = false;
+    queue.push_back( &task );
+    if ( queue.size() > idle )
+    {
+      ++idle;
+      std::thread( &thread_pool_t::work, this ).detach();
+    }
+    work_cv.notify_one();
+  }
+
+  void wait( task_t& task )
+  {
+    std::unique_lock<std::mutex> lock( m );
+    done_cv.wait( lock, [ &task ] { return task.done; } );
+  }
+};
+
+} // anonymous namespace
+
 class sc_thread_t::native_t
 {
 private:
   std::unique_ptr<std::thread> t;
+  thread_pool_t::task_t task;
 
   static void execute( sc_thread_t* t )
   {
@@ -48,21 +130,34 @@ private:
   }
 public:
   native_t() :
-  t()
+  t(), task()
   { }
 
   std::thread::id id() const
-  { return t -> get_id(); }
+  { return t ? t -> get_id() : task.id; }
 
   void launch( sc_thread_t* thr)
   {
-    t = std::make_unique<std::thread>( &sc_thread_t::native_t::execute, thr );
+    if ( reuse_threads_enabled )
+    {
+      task.entry = &sc_thread_t::native_t::execute;
+      task.thread = thr;
+      thread_pool_t::instance().submit( task );
+    }
+    else
+    {
+      t = std::make_unique<std::thread>( &sc_thread_t::native_t::execute, thr );
+    }
   }
 
   void join() {
     if ( t && t -> joinable() ) {
       t -> join();
     }
+    else if ( ! t && task.thread )
+    {
+      thread_pool_t::instance().wait( task );
+    }
   }
 
   static void sleep_seconds( double t )
@@ -119,6 +214,15 @@ std::thread::id sc_thread_t::thread_id() const
   return native_handle -> id();
 }
 
+/**
+ * @brief Run subsequently launched threads on a process-wide set of parked
+ * worker threads instead of creating a new thread for every launch.
+ */
+void sc_thread_t::reuse_threads( bool enable )
+{
+  reuse_threads_enabled = enable;
+}
+
 /**
  * @brief put calling thread to sleep
  * @param t time in seconds
@@ -232,6 +336,9 @@ void sc_thread_t::sleep_seconds( double t )
 unsigned sc_thread_t::cpu_thread_count()
 { return native_t::cpu_thread_count(); }
 
+void sc_thread_t::reuse_threads( bool )
+{}
+
 #endif
 
 #if defined(SC_WINDOWS)
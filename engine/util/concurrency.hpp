@@ -51,6 +51,7 @@ public:
   void join();
   static void sleep_seconds( double );
   static unsigned cpu_thread_count();
+  static void reuse_threads( bool enable );
 };
 
 class auto_lock_t
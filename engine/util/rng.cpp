@@ -8,6 +8,16 @@
 #include <cstdint>
 #include <algorithm>
 
+// The four lane xoshiro256+ engine is stepped with integer vector operations where the build
+// targets them, and with a plain lane loop otherwise.
+#if defined( __AVX2__ )
+#include <immintrin.h>
+#define SC_RNG_AVX2
+#elif defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#include <emmintrin.h>
+#define SC_RNG_SSE2
+#endif
+
 // Pseudo-Random Number Generation ==========================================
 
 namespace rng {
@@ -58,6 +68,13 @@ constexpr uint64_t rotl( const uint64_t x, int k ) {
   return (x << k) | (x >> (64 - k));
 }
 
+template <typename Engine>
+void fill_from_next( Engine& engine, uint64_t* out, size_t n )
+{
+  for ( size_t i = 0; i < n; ++i )
+    out[ i ] = engine.next();
+}
+
 } // anon namespace
 
 /**
@@ -75,6 +92,11 @@ uint64_t xorshift128_t::next() noexcept
   return ( s[ 1 ] = ( s1 ^ s0 ^ ( s1 >> 17 ) ^ ( s0 >> 26 ) ) ) + s0; // b, c
 }
 
+void xorshift128_t::fill( uint64_t* out, size_t n ) noexcept
+{
+  fill_from_next( *this, out, n );
+}
+
 void xorshift128_t::seed( uint64_t start ) noexcept
 {
   init_state_from_mix64(s, start);
@@ -113,6 +135,11 @@ uint64_t xoshiro256plus_t::next() noexcept
   return result;
 }
 
+void xoshiro256plus_t::fill( uint64_t* out, size_t n ) noexcept
+{
+  fill_from_next( *this, out, n );
+}
+
 void xoshiro256plus_t::seed( uint64_t start ) noexcept
 {
   init_state_from_mix64(s, start);
@@ -139,6 +166,11 @@ uint64_t xorshift1024_t::next() noexcept
   return ( s[ p ] = s0 ^ s1 ) * 1181783497276652981LL;
 }
 
+void xorshift1024_t::fill( uint64_t* out, size_t n ) noexcept
+{
+  fill_from_next( *this, out, n );
+}
+
 void xorshift1024_t::seed( uint64_t start ) noexcept
 {
   init_state_from_mix64(s, start);
@@ -149,6 +181,174 @@ const char* xorshift1024_t::name() const noexcept
   return "xorshift1024";
 }
 
+/**
+ * @brief Four lane xoshiro256+ Random Number Generator
+ *
+ * Each lane is a regular xoshiro256+ generator, seeded from consecutive SplitMix64 outputs.
+ */
+void xoshiro256plus_x4_t::fill( uint64_t* out, size_t n ) noexcept
+{
+  uint64_t tail[ 4 ];
+  const size_t blocks = ( n + 3 ) / 4;
+
+#if defined( SC_RNG_AVX2 )
+  __m256i s0 = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( s + 0 ) );
+  __m256i s1 = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( s + 4 ) );
+  __m256i s2 = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( s + 8 ) );
+  __m256i s3 = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( s + 12 ) );
+
+  for ( size_t b = 0; b < blocks; ++b )
+  {
+    uint64_t* dst = b * 4 + 4 <= n ? out + b * 4 : tail;
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( dst ), _mm256_add_epi64( s0, s3 ) );
+
+    const __m256i t = _mm256_slli_epi64( s1, 17 );
+    s2 = _mm256_xor_si256( s2, s0 );
+    s3 = _mm256_xor_si256( s3, s1 );
+    s1 = _mm256_xor_si256( s1, s2 );
+    s0 = _mm256_xor_si256( s0, s3 );
+    s2 = _mm256_xor_si256( s2, t );
+    s3 = _mm256_or_si256( _mm256_slli_epi64( s3, 45 ), _mm256_srli_epi64( s3, 19 ) );
+  }
+
+  _mm256_storeu_si256( reinterpret_cast<__m256i*>( s + 0 ), s0 );
+  _mm256_storeu_si256( reinterpret_cast<__m256i*>( s + 4 ), s1 );
+  _mm256_storeu_si256( reinterpret_cast<__m256i*>( s + 8 ), s2 );
+  _mm256_storeu_si256( reinterpret_cast<__m256i*>( s + 12 ), s3 );
+#elif defined( SC_RNG_SSE2 )
+  // Lanes 0-1 in the low registers, lanes 2-3 in the high registers
+  __m128i s0l = _mm_loadu_si128( reinterpret_cast<const __m128i*>( s + 0 ) );
+  __m128i s0h = _mm_loadu_si128( reinterpret_cast<const __m128i*>( s + 2 ) );
+  __m128i s1l = _mm_loadu_si128( reinterpret_cast<const __m128i*>( s + 4 ) );
+  __m128i s1h = _mm_loadu_si128( reinterpret_cast<const __m128i*>( s + 6 ) );
+  __m128i s2l = _mm_loadu_si128( reinterpret_cast<const __m128i*>( s + 8 ) );
+  __m128i s2h = _mm_loadu_si128( reinterpret_cast<const __m128i*>( s + 10 ) );
+  __m128i s3l = _mm_loadu_si128( reinterpret_cast<const __m128i*>( s + 12 ) );
+  __m128i s3h = _mm_loadu_si128( reinterpret_cast<const __m128i*>( s + 14 ) );
+
+  for ( size_t b = 0; b < blocks; ++b )
+  {
+    uint64_t* dst = b * 4 + 4 <= n ? out + b * 4 : tail;
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( dst ), _mm_add_epi64( s0l, s3l ) );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( dst + 2 ), _mm_add_epi64( s0h, s3h ) );
+
+    const __m128i tl = _mm_slli_epi64( s1l, 17 );
+    const __m128i th = _mm_slli_epi64( s1h, 17 );
+    s2l = _mm_xor_si128( s2l, s0l );
+    s2h = _mm_xor_si128( s2h, s0h );
+    s3l = _mm_xor_si128( s3l, s1l );
+    s3h = _mm_xor_si128( s3h, s1h );
+    s1l = _mm_xor_si128( s1l, s2l );
+    s1h = _mm_xor_si128( s1h, s2h );
+    s0l = _mm_xor_si128( s0l, s3l );
+    s0h = _mm_xor_si128( s0h, s3h );
+    s2l = _mm_xor_si128( s2l, tl );
+    s2h = _mm_xor_si128( s2h, th );
+    s3l = _mm_or_si128( _mm_slli_epi64( s3l, 45 ), _mm_srli_epi64( s3l, 19 ) );
+    s3h = _mm_or_si128( _mm_slli_epi64( s3h, 45 ), _mm_srli_epi64( s3h, 19 ) );
+  }
+
+  _mm_storeu_si128( reinterpret_cast<__m128i*>( s + 0 ), s0l );
+  _mm_storeu_si128( reinterpret_cast<__m128i*>( s + 2 ), s0h );
+  _mm_storeu_si128( reinterpret_cast<__m128i*>( s + 4 ), s1l );
+  _mm_storeu_si128( reinterpret_cast<__m128i*>( s + 6 ), s1h );
+  _mm_storeu_si128( reinterpret_cast<__m128i*>( s + 8 ), s2l );
+  _mm_storeu_si128( reinterpret_cast<__m128i*>( s + 10 ), s2h );
+  _mm_storeu_si128( reinterpret_cast<__m128i*>( s + 12 ), s3l );
+  _mm_storeu_si128( reinterpret_cast<__m128i*>( s + 14 ), s3h );
+#else
+  for ( size_t b = 0; b < blocks; ++b )
+  {
+    uint64_t* dst = b * 4 + 4 <= n ? out + b * 4 : tail;
+    for ( size_t l = 0; l < 4; ++l )
+    {
+      dst[ l ] = s[ l ] + s[ 12 + l ];
+
+      const uint64_t t = s[ 4 + l ] << 17;
+      s[ 8 + l ] ^= s[ l ];
+      s[ 12 + l ] ^= s[ 4 + l ];
+      s[ 4 + l ] ^= s[ 8 + l ];
+      s[ l ] ^= s[ 12 + l ];
+      s[ 8 + l ] ^= t;
+      s[ 12 + l ] = rotl( s[ 12 + l ], 45 );
+    }
+  }
+#endif
+
+  for ( size_t i = n - n % 4; i < n; ++i )
+    out[ i ] = tail[ i % 4 ];
+}
+
+void xoshiro256plus_x4_t::seed( uint64_t start ) noexcept
+{
+  split_mix64_t mix64;
+  mix64.seed( start );
+  for ( size_t l = 0; l < 4; ++l )
+  {
+    for ( size_t w = 0; w < 4; ++w )
+      s[ w * 4 + l ] = mix64.next();
+  }
+}
+
+const char* xoshiro256plus_x4_t::name() const noexcept
+{
+  return "xoshiro256+x4";
+}
+
+void sim_engine_t::fill( uint64_t* out, size_t n ) noexcept
+{
+  if ( vectorized )
+    lanes.fill( out, n );
+  else
+    scalar.fill( out, n );
+}
+
+void sim_engine_t::seed( uint64_t start ) noexcept
+{
+  if ( vectorized )
+    lanes.seed( start );
+  else
+    scalar.seed( start );
+}
+
+const char* sim_engine_t::name() const noexcept
+{
+  return vectorized ? lanes.name() : scalar.name();
+}
+
+/**
+ * @brief Layer table of the 128 layer ziggurat for the standard normal distribution
+ *
+ * Layer edges follow from the tail start r and the common layer area v, see Doornik (2005).
+ */
+const detail::ziggurat_table_t& detail::ziggurat_table()
+{
+  static const ziggurat_table_t table = [] {
+    const double r = 3.442619855899;
+    const double v = 9.91256303526217e-3;
+
+    ziggurat_table_t t;
+    t.r = r;
+
+    double f = std::exp( -0.5 * r * r );
+    t.x[ 0 ] = v / f;
+    t.x[ 1 ] = r;
+    t.x[ ziggurat_table_t::LAYERS ] = 0;
+    for ( unsigned i = 2; i < ziggurat_table_t::LAYERS; ++i )
+    {
+      t.x[ i ] = std::sqrt( -2.0 * std::log( v / t.x[ i - 1 ] + f ) );
+      f = std::exp( -0.5 * t.x[ i ] * t.x[ i ] );
+    }
+
+    for ( unsigned i = 0; i < ziggurat_table_t::LAYERS; ++i )
+      t.ratio[ i ] = t.x[ i + 1 ] / t.x[ i ];
+
+    return t;
+  }();
+
+  return table;
+}
+
 /**
  * @brief The standard normal CDF, for one random variable.
  *
@@ -330,6 +530,7 @@ double stdnormal_inv( double p )
 
 #include <random>
 #include <tuple>
+#include <vector>
 
 #include "lib/fmt/format.h"
 #include "util/generic.hpp"
@@ -416,11 +617,160 @@ static void test_uniform_int( rng::basic_rng_t<Engine>& rng, uint64_t n, unsigne
   {
     double pct = static_cast<double>(histogram[ i ]) / n;
     double diff = static_cast<double>(histogram[ i ]) / expected_bucket_size - 1.0;
-    fmt::print("  bucket {:2n}: {:5.2f}% ({}) difference to expected: {:9.6f}%\n", i, pct, histogram[ i ], diff);
+    fmt::print("  bucket {:2}: {:5.2f}% ({}) difference to expected: {:9.6f}%\n", i, pct, histogram[ i ], diff);
   }
   fmt::print("time = {} s\n\n", elapsed_cpu);
 }
 
+// Compare the buffered stream against the engine stepped directly, and the vector engine against its scalar lane
+static void test_reproducible( uint64_t seed )
+{
+  rng::basic_rng_t<rng::xoshiro256plus_t> buffered;
+  rng::xoshiro256plus_t direct;
+  buffered.seed( seed );
+  direct.seed( seed );
+
+  bool same = true;
+  for ( unsigned i = 0; i < 1'000'000; ++i )
+  {
+    uint64_t ui64 = direct.next();
+    ui64 &= 0x000fffffffffffff;
+    ui64 |= 0x3ff0000000000000;
+    union { uint64_t ui64; double d; } u;
+    u.ui64 = ui64;
+    same = same && buffered.real() == u.d - 1.0;
+  }
+  fmt::print( "buffered xoshiro256+ stream equals direct engine stream: {}\n", same ? "ok" : "FAIL" );
+
+  rng::xoshiro256plus_x4_t lanes;
+  rng::xoshiro256plus_t lane0;
+  lanes.seed( seed );
+  lane0.seed( seed );
+
+  // Odd block sizes exercise the partial block handling
+  std::vector<uint64_t> out;
+  size_t sizes[] = { 64, 4, 8, 12, 64 };
+  for ( auto size : sizes )
+  {
+    out.resize( out.size() + size );
+    lanes.fill( out.data() + out.size() - size, size );
+  }
+  same = true;
+  for ( size_t i = 0; i < out.size(); i += 4 )
+    same = same && out[ i ] == lane0.next();
+  fmt::print( "xoshiro256+x4 lane 0 equals xoshiro256+: {}\n", same ? "ok" : "FAIL" );
+
+  rng::rng_t a, b;
+  a.vectorize( true );
+  b.vectorize( true );
+  a.seed( seed );
+  b.seed( seed );
+  same = true;
+  for ( unsigned i = 0; i < 1'000'000; ++i )
+    same = same && a.gauss( 0, 1 ) == b.gauss( 0, 1 ) && a.real() == b.real();
+  fmt::print( "vectorized rng reproducible for a seed: {}\n\n", same ? "ok" : "FAIL" );
+}
+
+// Moments and goodness of fit of uniform and standard normal output
+template <typename Rng>
+static void test_statistics( Rng& rng, uint64_t n )
+{
+  const unsigned num_buckets = 100;
+  std::vector<uint64_t> histogram( num_buckets );
+  double sum = 0, sum_sq = 0;
+  for ( uint64_t i = 0; i < n; ++i )
+  {
+    double d = rng.real();
+    sum += d;
+    sum_sq += d * d;
+    histogram[ static_cast<size_t>( d * num_buckets ) ] += 1;
+  }
+
+  double mean = sum / n;
+  double variance = sum_sq / n - mean * mean;
+  double expected = static_cast<double>( n ) / num_buckets;
+  double chi_sq = 0;
+  for ( auto count : histogram )
+    chi_sq += ( count - expected ) * ( count - expected ) / expected;
+
+  // Five standard errors, and five standard deviations of the chi-square distribution
+  bool ok = std::fabs( mean - 0.5 ) < 5 * std::sqrt( 1 / 12.0 / n ) &&
+            std::fabs( variance - 1 / 12.0 ) < 5 * std::sqrt( 1 / 180.0 / n ) &&
+            chi_sq < ( num_buckets - 1 ) + 5 * std::sqrt( 2.0 * ( num_buckets - 1 ) );
+  fmt::print( "rng::{}::real(): mean = {:.6f}, variance = {:.6f}, chi-square({}) = {:.1f}: {}\n",
+              rng.name(), mean, variance, num_buckets - 1, chi_sq, ok ? "ok" : "FAIL" );
+
+  std::vector<double> sample( n );
+  sum = sum_sq = 0;
+  double sum_cu = 0, sum_qu = 0;
+  uint64_t tail = 0;
+  for ( auto& z : sample )
+  {
+    z = rng.gauss( 0, 1 );
+    sum += z;
+    sum_sq += z * z;
+    sum_cu += z * z * z;
+    sum_qu += z * z * z * z;
+    tail += std::fabs( z ) > 3.442619855899;
+  }
+
+  mean = sum / n;
+  variance = sum_sq / n - mean * mean;
+  double skewness = sum_cu / n;
+  double kurtosis = sum_qu / n;
+
+  // Kolmogorov-Smirnov distance to the standard normal distribution
+  range::sort( sample );
+  double ks = 0;
+  for ( size_t i = 0; i < sample.size(); ++i )
+  {
+    double cdf = rng::stdnormal_cdf( sample[ i ] );
+    ks = std::max( { ks, cdf - static_cast<double>( i ) / n, static_cast<double>( i + 1 ) / n - cdf } );
+  }
+
+  double expected_tail = 2 * ( 1 - rng::stdnormal_cdf( 3.442619855899 ) );
+  ok = std::fabs( mean ) < 5 / std::sqrt( n ) && std::fabs( variance - 1 ) < 5 * std::sqrt( 2.0 / n ) &&
+       std::fabs( skewness ) < 5 * std::sqrt( 15.0 / n ) && std::fabs( kurtosis - 3 ) < 5 * std::sqrt( 96.0 / n ) &&
+       ks * std::sqrt( n ) < 1.95 &&
+       std::fabs( tail - expected_tail * n ) < 5 * std::sqrt( expected_tail * n );
+  fmt::print( "rng::{}::gauss(0, 1): mean = {:.6f}, variance = {:.6f}, skewness = {:.6f}, kurtosis = {:.6f}, "
+              "KS = {:.6f}, tail = {:.3e} ( expected {:.3e} ): {}\n\n",
+              rng.name(), mean, variance, skewness, kurtosis, ks, static_cast<double>( tail ) / n, expected_tail,
+              ok ? "ok" : "FAIL" );
+}
+
+// Throughput of the scalar and the vectorized simulator rng
+static void test_throughput( uint64_t seed, uint64_t n )
+{
+  for ( bool vectorized : { false, true } )
+  {
+    rng::rng_t rng;
+    rng.vectorize( vectorized );
+    rng.seed( seed );
+
+    auto start_time = test_clock::now();
+    double average = 0;
+    for ( uint64_t i = 0; i < n; ++i )
+      average += rng.real();
+    auto elapsed_real = chrono::elapsed_fp_seconds( start_time );
+
+    start_time = test_clock::now();
+    for ( uint64_t i = 0; i < n; ++i )
+      average += rng.gauss( 0, 1 );
+    auto elapsed_gauss = chrono::elapsed_fp_seconds( start_time );
+
+    start_time = test_clock::now();
+    for ( uint64_t i = 0; i < n; ++i )
+      average += rng.exgauss( 0.3, 0.06, 0.25 );
+    auto elapsed_exgauss = chrono::elapsed_fp_seconds( start_time );
+
+    fmt::print( "{} rng::{}: real = {:.1f}M/s, gauss = {:.1f}M/s, exgauss = {:.1f}M/s ( {:.3f} )\n",
+                n, rng.name(), n / elapsed_real / 1e6, n / elapsed_gauss / 1e6, n / elapsed_exgauss / 1e6,
+                average / n );
+  }
+  fmt::print( "\n" );
+}
+
 namespace detail {
 template <typename Tuple, typename F, std::size_t... I>
 void for_each_impl(Tuple&& t, F&& f, std::index_sequence<I...>)
@@ -439,11 +789,12 @@ void for_each(Tuple&& t, F&& f)
 
 int main( int /*argc*/, char** /*argv*/ )
 {
-  auto generators = std::make_tuple(
-    rng::basic_rng_t<rng::xoshiro256plus_t>{},
-    rng::basic_rng_t<rng::xorshift128_t>{},
-    rng::basic_rng_t<rng::xorshift1024_t>{}
-  );
+  std::tuple<
+    rng::basic_rng_t<rng::xoshiro256plus_t>,
+    rng::basic_rng_t<rng::xoshiro256plus_x4_t>,
+    rng::basic_rng_t<rng::xorshift128_t>,
+    rng::basic_rng_t<rng::xorshift1024_t>
+  > generators;
 
   std::random_device rd;
   uint64_t seed  = uint64_t(rd()) | (uint64_t(rd()) << 32);
@@ -451,6 +802,19 @@ int main( int /*argc*/, char** /*argv*/ )
 
   for_each( generators, [seed]( auto& g ) { g.seed( seed ); } );
 
+  test_reproducible( seed );
+
+  for_each( generators, []( auto& g ) { test_statistics( g, 10'000'000 ); } );
+
+  {
+    rng::rng_t batched;
+    batched.vectorize( true );
+    batched.seed( seed );
+    test_statistics( batched, 10'000'000 );
+  }
+
+  test_throughput( seed, 100'000'000 );
+
   for_each( generators, []( auto& g ) { test_one( g, 1'000'000'000 ); } );
 
   for_each( generators, []( auto& g ) { monte_carlo( g, 1'000'000'000 ); } );
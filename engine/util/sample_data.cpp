@@ -1,8 +1,149 @@
 
 #include "sample_data.hpp"
 
+#include <cmath>
 #include <ostream>
 
+namespace
+{
+const double pi = 3.14159265358979323846;
+
+// t-digest scale function k1: k( q ) = compression / ( 2 pi ) * asin( 2q - 1 ). A centroid may span
+// at most one unit of k, which keeps centroids small near q = 0 and q = 1.
+double max_quantile( double q, double compression )
+{
+  double k = compression / ( 2 * pi ) * std::asin( 2 * q - 1 ) + 1;
+  if ( k >= compression / 4 )
+    return 1.0;
+
+  return ( std::sin( k * 2 * pi / compression ) + 1 ) / 2;
+}
+}  // namespace
+
+void quantile_sketch_t::merge( const quantile_sketch_t& other )
+{
+  buffer.insert( buffer.end(), other.centroids.begin(), other.centroids.end() );
+  buffer.insert( buffer.end(), other.buffer.begin(), other.buffer.end() );
+  total_weight += other.total_weight;
+  _min = other._min < _min ? other._min : _min;
+  _max = other._max > _max ? other._max : _max;
+
+  if ( buffer.size() >= buffer_limit() )
+    compress();
+}
+
+void quantile_sketch_t::compress()
+{
+  if ( buffer.empty() )
+    return;
+
+  buffer.insert( buffer.end(), centroids.begin(), centroids.end() );
+  range::sort( buffer, []( const centroid_t& a, const centroid_t& b ) { return a.mean < b.mean; } );
+  centroids.clear();
+
+  double weight_so_far = 0;
+  double weight_limit  = total_weight * max_quantile( 0, compression );
+  centroid_t current   = buffer.front();
+
+  for ( size_t i = 1; i < buffer.size(); ++i )
+  {
+    const centroid_t& next = buffer[ i ];
+    if ( weight_so_far + current.weight + next.weight <= weight_limit )
+    {
+      current.weight += next.weight;
+      current.mean += ( next.mean - current.mean ) * next.weight / current.weight;
+    }
+    else
+    {
+      weight_so_far += current.weight;
+      centroids.push_back( current );
+      weight_limit = total_weight * max_quantile( weight_so_far / total_weight, compression );
+      current      = next;
+    }
+  }
+
+  centroids.push_back( current );
+  buffer.clear();
+}
+
+double quantile_sketch_t::quantile( double q ) const
+{
+  assert( compressed() );
+
+  if ( centroids.empty() )
+    return 0;
+
+  if ( centroids.size() == 1 )
+    return centroids.front().mean;
+
+  // Interpolate between centroid centers, and between the outermost centers and the exact min/max
+  double index = q * total_weight;
+
+  const centroid_t& first = centroids.front();
+  if ( index < first.weight / 2 )
+    return _min + ( first.mean - _min ) * index / ( first.weight / 2 );
+
+  const centroid_t& last = centroids.back();
+  if ( index > total_weight - last.weight / 2 )
+    return _max - ( _max - last.mean ) * ( total_weight - index ) / ( last.weight / 2 );
+
+  double center = first.weight / 2;
+  for ( size_t i = 0; i + 1 < centroids.size(); ++i )
+  {
+    double gap = ( centroids[ i ].weight + centroids[ i + 1 ].weight ) / 2;
+    if ( index <= center + gap )
+    {
+      return centroids[ i ].mean + ( centroids[ i + 1 ].mean - centroids[ i ].mean ) * ( index - center ) / gap;
+    }
+    center += gap;
+  }
+
+  return last.mean;
+}
+
+double quantile_sketch_t::cdf( double x ) const
+{
+  assert( compressed() );
+
+  if ( centroids.empty() || x < _min )
+    return 0;
+
+  if ( x >= _max )
+    return 1;
+
+  if ( centroids.size() == 1 )
+    return ( x - _min ) / ( _max - _min );
+
+  const centroid_t& first = centroids.front();
+  if ( x < first.mean )
+  {
+    double fraction = first.mean > _min ? ( x - _min ) / ( first.mean - _min ) : 1;
+    return fraction * first.weight / 2 / total_weight;
+  }
+
+  const centroid_t& last = centroids.back();
+  if ( x >= last.mean )
+  {
+    double fraction = _max > last.mean ? ( _max - x ) / ( _max - last.mean ) : 0;
+    return 1 - fraction * last.weight / 2 / total_weight;
+  }
+
+  double center = first.weight / 2;
+  for ( size_t i = 0; i + 1 < centroids.size(); ++i )
+  {
+    double gap = ( centroids[ i ].weight + centroids[ i + 1 ].weight ) / 2;
+    if ( x < centroids[ i + 1 ].mean )
+    {
+      double span = centroids[ i + 1 ].mean - centroids[ i ].mean;
+      double fraction = span > 0 ? ( x - centroids[ i ].mean ) / span : 0;
+      return ( center + fraction * gap ) / total_weight;
+    }
+    center += gap;
+  }
+
+  return 1;
+}
+
 std::ostream& extended_sample_data_t::data_str( std::ostream& s ) const
   {
     s << "Sample_Data \"" << name_str << "\": count: " << count();
@@ -24,6 +165,8 @@ std::ostream& extended_sample_data_t::data_str( std::ostream& s ) const
 
 #ifdef UNIT_TEST
 #include <iostream>
+#include <random>
+#include <sstream>
 
 int main( int /*argc*/, char** /*argv*/ )
 {
@@ -34,11 +177,50 @@ int main( int /*argc*/, char** /*argv*/ )
   for( int i = 0; i < 1000; ++i )
     z.add( rand() );
 
-  z.analyze_all();
+  z.analyze();
 
   std::ostringstream s;
   z.data_str( s );
   std::cout << s.str();
+
+  // Compare streamed ( sketched ) statistics against exact ones, merging from several "threads"
+  std::mt19937_64 engine( 42 );
+  std::gamma_distribution<double> dist( 4.0, 1000.0 );
+  extended_sample_data_t exact( "exact", false ), sketched( "sketched", false );
+  sketched.enable_sketch( 200 );
+  for ( int thread = 0; thread < 8; ++thread )
+  {
+    extended_sample_data_t exact_thread( "exact", false ), sketched_thread( "sketched", false );
+    sketched_thread.enable_sketch( 200 );
+    for ( int i = 0; i < 125000; ++i )
+    {
+      double v = dist( engine );
+      exact_thread.add( v );
+      sketched_thread.add( v );
+    }
+    exact.merge( exact_thread );
+    sketched.merge( sketched_thread );
+  }
+
+  exact.analyze();
+  sketched.analyze();
+
+  std::cout << "mean: " << exact.mean() << " / " << sketched.mean() << "\n";
+  std::cout << "std_dev: " << exact.std_dev << " / " << sketched.std_dev << "\n";
+  for ( double q : { 0.001, 0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99, 0.999 } )
+  {
+    std::cout << "p" << q * 100 << ": " << exact.percentile( q ) << " / " << sketched.percentile( q )
+              << " (" << ( sketched.percentile( q ) / exact.percentile( q ) - 1 ) * 100 << "%)\n";
+  }
+
+  size_t max_bucket_error = 0;
+  for ( size_t i = 0; i < exact.distribution.size(); ++i )
+  {
+    auto a = exact.distribution[ i ], b = sketched.distribution[ i ];
+    max_bucket_error = std::max( max_bucket_error, a > b ? a - b : b - a );
+  }
+  std::cout << "max histogram bucket error: " << max_bucket_error << " of " << exact.count() << "\n";
+
   return 0;
 }
 #endif // UNIT_TEST
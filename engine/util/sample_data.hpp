@@ -247,6 +247,14 @@ public:
     _count = 0u;
     _sum   = 0.0;
   }
+
+  // Write to / read from a binary archive ( see util/archive.hpp )
+  template <typename Archive>
+  void serialize( Archive& ar )
+  {
+    ar( _sum );
+    ar( _count );
+  }
 };
 
 /* Second simplest Samplest Data container. Tracks sum, count as well as min/max
@@ -302,11 +310,123 @@ public:
     _min = std::numeric_limits<value_t>::max();
     _max = std::numeric_limits<value_t>::lowest();
   }
+
+  template <typename Archive>
+  void serialize( Archive& ar )
+  {
+    base_t::serialize( ar );
+    ar( _min );
+    ar( _max );
+  }
+};
+
+/* Mergeable streaming quantile sketch ( merging t-digest, Dunning & Ertl )
+ *
+ * Samples are summarized into at most ~compression weighted centroids, so memory use does not
+ * depend on the number of samples. Centroids are kept small near the tails, which makes extreme
+ * percentiles more accurate than the ones near the median. Larger compression values trade memory
+ * for accuracy.
+ */
+class quantile_sketch_t
+{
+public:
+  struct centroid_t
+  {
+    double mean;
+    double weight;
+  };
+
+private:
+  double compression;
+  std::vector<centroid_t> centroids;  // compressed, sorted by mean
+  std::vector<centroid_t> buffer;     // samples and centroids not compressed yet
+  double total_weight;
+  double _min, _max;
+
+  size_t buffer_limit() const
+  {
+    return static_cast<size_t>( 5 * compression ) + 1;
+  }
+
+public:
+  quantile_sketch_t()
+    : compression( 0 ),
+      total_weight( 0 ),
+      _min( std::numeric_limits<double>::max() ),
+      _max( std::numeric_limits<double>::lowest() )
+  {
+  }
+
+  void set_compression( double c )
+  {
+    compression = c;
+  }
+
+  bool enabled() const
+  {
+    return compression > 0;
+  }
+
+  void add( double x )
+  {
+    buffer.push_back( { x, 1.0 } );
+    total_weight += 1.0;
+    _min = x < _min ? x : _min;
+    _max = x > _max ? x : _max;
+
+    if ( buffer.size() >= buffer_limit() )
+      compress();
+  }
+
+  void merge( const quantile_sketch_t& other );
+
+  // Fold buffered samples into the centroids. Required before quantile() and cdf().
+  void compress();
+
+  bool compressed() const
+  {
+    return buffer.empty();
+  }
+
+  // Approximate value at quantile q ( 0 <= q <= 1 )
+  double quantile( double q ) const;
+
+  // Approximate fraction of samples less than or equal to x
+  double cdf( double x ) const;
+
+  size_t size() const
+  {
+    return centroids.size() + buffer.size();
+  }
+
+  void clear()
+  {
+    centroids.clear();
+    buffer.clear();
+    total_weight = 0;
+    _min = std::numeric_limits<double>::max();
+    _max = std::numeric_limits<double>::lowest();
+  }
+
+  template <typename Archive>
+  void serialize( Archive& ar )
+  {
+    ar( compression );
+    ar( centroids );
+    ar( buffer );
+    ar( total_weight );
+    ar( _min );
+    ar( _max );
+  }
 };
 
 /* Extensive sample_data container with two runtime dependent modes:
  * - simple: Only offers sum, count
  *  -!simple: saves data and offers variance, percentiles, distribution, etc.
+ *
+ * A !simple container can alternatively stream its samples ( see enable_sketch() ). It then keeps
+ * a running mean and variance and a quantile sketch instead of the data, so percentiles and the
+ * distribution are approximate, and data() / sorted_data() are empty.
  */
 class extended_sample_data_t : public simple_sample_data_with_min_max_t
 {
@@ -326,6 +446,10 @@ private:
                                       // to do regression on it )
   bool is_sorted;
 
+  // Streaming mode: running mean / sum of squared deviations ( Welford ) and quantile sketch
+  value_t _running_mean, _running_m2;
+  quantile_sketch_t _sketch;
+
 public:
   explicit extended_sample_data_t( util::string_view n, bool s = true )
     : base_t(),
@@ -336,7 +460,9 @@ public:
       mean_variance(),
       mean_std_dev(),
       simple( s ),
-      is_sorted( false )
+      is_sorted( false ),
+      _running_mean(),
+      _running_m2()
   {
   }
 
@@ -347,6 +473,21 @@ public:
     clear();
   }
 
+  // Stream samples into a quantile sketch of the given compression instead of storing them. Only
+  // has an effect while the container is not simple.
+  void enable_sketch( unsigned compression )
+  {
+    _sketch.set_compression( compression );
+
+    clear();
+  }
+
+  // Percentiles and distribution are estimated from a sketch
+  bool approximate() const
+  {
+    return !simple && _sketch.enabled();
+  }
+
   const char* name() const
   {
     return name_str.c_str();
@@ -355,7 +496,7 @@ public:
   // Reserve memory
   void reserve( std::size_t capacity )
   {
-    if ( !simple )
+    if ( !simple && !_sketch.enabled() )
       _data.reserve( capacity );
   }
 
@@ -366,6 +507,17 @@ public:
     {
       base_t::add( x );
     }
+    else if ( _sketch.enabled() )
+    {
+      base_t::add( x );
+
+      value_t delta = x - _running_mean;
+      _running_mean += delta / base_t::count();
+      _running_m2 += delta * ( x - _running_mean );
+
+      _sketch.add( x );
+      is_sorted = false;
+    }
     else
     {
       _data.push_back( x );
@@ -380,7 +532,7 @@ public:
 
   size_t size() const
   {
-    if ( simple )
+    if ( simple || _sketch.enabled() )
       return base_t::count();
 
     return _data.size();
@@ -405,6 +557,13 @@ public:
     if ( simple )
       return;
 
+    if ( _sketch.enabled() )
+    {
+      // Sum, count and min/max are tracked when adding samples
+      _mean = _running_mean;
+      return;
+    }
+
     if ( data().empty() )
       return;
 
@@ -434,7 +593,7 @@ public:
   }
   size_t count() const
   {
-    return simple ? base_t::count() : data().size();
+    return size();
   }
 
   /* Analyze Variance: Variance, Stddev and Stddev of the mean
@@ -445,16 +604,19 @@ public:
     if ( simple )
       return;
 
-    if ( _data.empty() )
+    if ( size() == 0 )
       return;
 
-    variance = statistics::calculate_variance( data(), mean() );
+    if ( _sketch.enabled() )
+      variance = _running_m2 / size();
+    else
+      variance = statistics::calculate_variance( data(), mean() );
     std_dev  = std::sqrt( variance );
 
     // Calculate Standard Deviation of the Mean ( Central Limit Theorem )
-    if ( data().size() > 1 )
+    if ( size() > 1 )
     {
-      mean_variance = variance / data().size();
+      mean_variance = variance / size();
       mean_std_dev  = std::sqrt( mean_variance );
     }
   }
@@ -471,6 +633,12 @@ public:
     {
       return;
     }
+    if ( _sketch.enabled() )
+    {
+      _sketch.compress();
+      is_sorted = true;
+      return;
+    }
     _sorted_data = _data;
     range::sort( _sorted_data );
     is_sorted = true;
@@ -485,11 +653,44 @@ public:
     if ( simple )
       return;
 
-    if ( data().empty() )
+    if ( size() == 0 )
       return;
 
-    distribution = statistics::create_histogram( data(), num_buckets,
-                                                 base_t::min(), base_t::max() );
+    distribution = histogram( num_buckets, base_t::min(), base_t::max() );
+  }
+
+  /* Histogram ( not normalized ) of the data with the given bounds. Estimated from the quantile
+   * sketch when streaming.
+   *
+   * Requires: sort()
+   */
+  std::vector<size_t> histogram( size_t num_buckets, value_t min, value_t max ) const
+  {
+    if ( !_sketch.enabled() )
+      return statistics::create_histogram( data(), num_buckets, min, max );
+
+    std::vector<size_t> result;
+    if ( simple || size() == 0 || max <= min || !is_sorted )
+      return result;
+
+    // Bucket counts are differences of the rounded cumulative counts, so they always add up to
+    // the sample count.
+    result.assign( num_buckets, size_t{} );
+    size_t previous = 0;
+    for ( size_t i = 0; i < num_buckets; ++i )
+    {
+      size_t cumulative = size();
+      if ( i + 1 < num_buckets )
+      {
+        auto edge  = min + ( max - min ) * ( i + 1 ) / num_buckets;
+        cumulative = static_cast<size_t>( std::round( _sketch.cdf( edge ) * size() ) );
+        cumulative = clamp( cumulative, previous, size() );
+      }
+      result[ i ] = cumulative - previous;
+      previous    = cumulative;
+    }
+
+    return result;
   }
 
   void clear()
@@ -498,6 +699,8 @@ public:
     _sorted_data.clear();
     _data.clear();
     distribution.clear();
+    _running_mean = _running_m2 = 0;
+    _sketch.clear();
   }
 
   // Access functions
@@ -510,12 +713,15 @@ public:
     if ( simple )
       return 0;
 
-    if ( data().empty() )
+    if ( size() == 0 )
       return 0;
 
     if ( !is_sorted )
       return base_t::nan();
 
+    if ( _sketch.enabled() )
+      return _sketch.quantile( x );
+
     // Should be improved to use linear interpolation
     return ( sorted_data()[ (int)( x * ( sorted_data().size() - 1 ) ) ] );
   }
@@ -532,15 +738,49 @@ public:
   void merge( const extended_sample_data_t& other )
   {
     assert( simple == other.simple );
+    assert( _sketch.enabled() == other._sketch.enabled() );
 
     if ( simple )
     {
       base_t::merge( other );
     }
+    else if ( _sketch.enabled() )
+    {
+      // Combine running mean and squared deviations of both sets ( Chan et al. )
+      auto n_this  = static_cast<value_t>( base_t::count() );
+      auto n_other = static_cast<value_t>( other.base_t::count() );
+      if ( n_other > 0 )
+      {
+        auto n     = n_this + n_other;
+        auto delta = other._running_mean - _running_mean;
+        _running_mean += delta * n_other / n;
+        _running_m2 += other._running_m2 + delta * delta * n_this * n_other / n;
+      }
+
+      base_t::merge( other );
+      _sketch.merge( other._sketch );
+      is_sorted = false;
+    }
     else
       _data.insert( _data.end(), other._data.begin(), other._data.end() );
   }
 
+  // Collected samples only, analysis results are recomputed after merging
+  template <typename Archive>
+  void serialize( Archive& ar )
+  {
+    base_t::serialize( ar );
+    ar( _data );
+    ar( _running_mean );
+    ar( _running_m2 );
+    ar( _sketch );
+    if ( ar.reading() )
+    {
+      _sorted_data.clear();
+      is_sorted = false;
+    }
+  }
+
   std::ostream& data_str( std::ostream& s ) const;
 
 };  // sample_data_t
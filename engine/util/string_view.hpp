@@ -27,6 +27,8 @@
 #define SC_UTIL_STRING_VIEW_HPP_INCLUDED
 
 #include <cassert>
+#include <cstdint>
+#include <functional>
 #include <limits>
 #include <string>
 
@@ -323,6 +325,21 @@ constexpr fmt::string_view to_string_view(string_view str) {
 
 } // namespace util
 
+// hashing support, FNV-1a over the characters
+namespace std {
+template <>
+struct hash<util::string_view> {
+  size_t operator()(util::string_view str) const noexcept {
+    uint64_t hash = 14695981039346656037ULL;
+    for (char c : str) {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 1099511628211ULL;
+    }
+    return static_cast<size_t>(hash);
+  }
+};
+} // namespace std
+
 // fmtlib support
 namespace fmt {
 template <>
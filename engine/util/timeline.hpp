@@ -76,6 +76,20 @@ inline Range& sliding_window_average( Range& r, unsigned window, Out out )
   return r;
 }
 
+// Vectorized kernels for timeline arithmetic ( AVX2 / SSE2 when the build targets them, scalar
+// otherwise ). Results are identical to the plain scalar loops.
+namespace timeline_kernel
+{
+// Name of the instruction set the kernels were built for
+const char* name();
+// dst[ i ] += src[ i ]
+void add( double* dst, const double* src, size_t n );
+// dst[ i ] /= divisor[ i ]
+void divide( double* dst, const double* divisor, size_t n );
+// out[ i ] = ( upper[ i ] - lower[ i ] ) / window
+void window_difference( double* out, const double* upper, const double* lower, size_t n, double window );
+}  // namespace timeline_kernel
+
 // generic Timeline class
 class timeline_t
 {
@@ -95,6 +109,10 @@ public:
   void resize( size_t length )
   { _data.resize( length ); }
 
+  // Preallocate room for 'length' entries, so add() does not need to reallocate
+  void reserve( size_t length )
+  { _data.reserve( length ); }
+
   // Add 'value' at the specific index
   void add( size_t index, double value )
   {
@@ -122,6 +140,12 @@ public:
     }
   }
 
+  void adjust( const std::vector<double>& divisor_timeline )
+  {
+    timeline_kernel::divide( _data.data(), divisor_timeline.data(),
+                             std::min( data().size(), divisor_timeline.size() ) );
+  }
+
   double mean() const
   { 
     if ( data().size() == 0 )
@@ -142,19 +166,19 @@ public:
   void merge( const timeline_t& other )
   {
     // merge shared range
-    for ( size_t j = 0, num_buckets = std::min( _data.size(), other.data().size() ); j < num_buckets; ++j )
-      _data[ j ] += other.data()[ j ];
+    timeline_kernel::add( _data.data(), other.data().data(), std::min( _data.size(), other.data().size() ) );
 
     // if other is larger, insert tail
     if ( _data.size() < other.data().size() )
       _data.insert( _data.end(), other.data().begin() + _data.size(), other.data().end() );
   }
 
-  void build_sliding_average_timeline( timeline_t& out, unsigned window ) const
-  {
-    out._data.reserve( data().size() );
-    sliding_window_average( data(), window, std::back_inserter( out._data ) );
-  }
+  // Write to / read from a binary archive ( see util/archive.hpp )
+  template <typename Archive>
+  void serialize( Archive& ar )
+  { ar( _data ); }
+
+  void build_sliding_average_timeline( timeline_t& out, unsigned window ) const;
 
   // Maximum value; 0 if no data available
   double max() const
@@ -241,11 +265,11 @@ public:
    */
   void create_histogram( const extended_sample_data_t& sd, size_t num_buckets, double min, double max )
   {
-    if ( sd.simple || sd.data().empty() )
+    if ( sd.simple || sd.size() == 0 )
       return;
     clear();
     _min = min; _max = max;
-    _data = statistics::create_histogram( sd.data(), num_buckets, _min, _max );
+    _data = sd.histogram( num_buckets, _min, _max );
     calculate_num_entries();
   }
 
@@ -253,8 +277,13 @@ public:
    */
   void create_histogram( const extended_sample_data_t& sd, size_t num_buckets )
   {
-    if ( sd.simple || sd.data().empty() )
+    if ( sd.simple || sd.size() == 0 )
       return;
+    if ( sd.approximate() )
+    {
+      create_histogram( sd, num_buckets, sd.min(), sd.max() );
+      return;
+    }
     double min = *std::min_element( sd.data().begin(), sd.data().end() );
     double max = *std::max_element( sd.data().begin(), sd.data().end() );
     create_histogram( sd, num_buckets, min, max );
@@ -369,6 +398,11 @@ struct sc_timeline_t : public timeline_t
   }
 
   using timeline_t::add;
+  using timeline_t::reserve;
+
+  // Preallocate all bins up to 'max_time'
+  void reserve( timespan_t max_time )
+  { timeline_t::reserve( bin_index( max_time ) + 1 ); }
 
   // Add 'value' at the corresponding time
   void add( timespan_t current_time, double value )
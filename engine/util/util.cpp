@@ -7,6 +7,7 @@
 #include "util/git_info.hpp"
 #include "player/sc_player.hpp"
 #include "sim/scale_factor_control.hpp"
+#include "dbc/data_bundle.hpp"
 #include "dbc/dbc.hpp"
 
 #include "lib/utf8-cpp/utf8.h"
@@ -277,6 +278,16 @@ std::string util::version_info_str( const dbc_t* dbc )
         dbc::hotfix_build_version( dbc->ptr ) );
   }
 
+  if ( dbc::bundle::loaded() )
+  {
+    if ( !build_info.empty() )
+    {
+      build_info += ", ";
+    }
+
+    build_info += fmt::format( "client data bundle {}", dbc::bundle::build( dbc->ptr ) );
+  }
+
   if ( git_info::available() )
   {
     if ( !build_info.empty() )
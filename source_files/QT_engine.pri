@@ -7,6 +7,7 @@ HEADERS += engine/action/attack.hpp
 HEADERS += engine/action/dbc_proc_callback.hpp
 HEADERS += engine/action/dot.hpp
 HEADERS += engine/action/heal.hpp
+HEADERS += engine/action/proc_dispatch.hpp
 HEADERS += engine/action/residual_action.hpp
 HEADERS += engine/action/sc_action.hpp
 HEADERS += engine/action/sc_action_state.hpp
@@ -15,6 +16,7 @@ HEADERS += engine/action/snapshot_stats.hpp
 HEADERS += engine/action/spell.hpp
 HEADERS += engine/action/spell_base.hpp
 HEADERS += engine/action/variable.hpp
+HEADERS += engine/buff/buff_registry.hpp
 HEADERS += engine/buff/sc_buff.hpp
 HEADERS += engine/class_modules/apl/mage.hpp
 HEADERS += engine/class_modules/class_module.hpp
@@ -28,6 +30,7 @@ HEADERS += engine/dbc/azerite.hpp
 HEADERS += engine/dbc/client_data.hpp
 HEADERS += engine/dbc/client_hotfix_entry.hpp
 HEADERS += engine/dbc/covenant_data.hpp
+HEADERS += engine/dbc/data_bundle.hpp
 HEADERS += engine/dbc/data_definitions.hh
 HEADERS += engine/dbc/data_enums.hh
 HEADERS += engine/dbc/dbc.hpp
@@ -145,12 +148,14 @@ HEADERS += engine/sim/sc_option.hpp
 HEADERS += engine/sim/sc_profileset.hpp
 HEADERS += engine/sim/sc_sim.hpp
 HEADERS += engine/sim/scale_factor_control.hpp
+HEADERS += engine/sim/shard.hpp
 HEADERS += engine/sim/shuffled_rng.hpp
 HEADERS += engine/sim/sim_control.hpp
 HEADERS += engine/sim/sim_ostream.hpp
 HEADERS += engine/sim/uptime.hpp
 HEADERS += engine/simulationcraft.hpp
 HEADERS += engine/util/allocator.hpp
+HEADERS += engine/util/archive.hpp
 HEADERS += engine/util/cache.hpp
 HEADERS += engine/util/chrono.hpp
 HEADERS += engine/util/concurrency.hpp
@@ -177,6 +182,7 @@ SOURCES += engine/action/absorb.cpp
 SOURCES += engine/action/action_callback.cpp
 SOURCES += engine/action/dbc_proc_callback.cpp
 SOURCES += engine/action/heal.cpp
+SOURCES += engine/action/proc_dispatch.cpp
 SOURCES += engine/action/residual_action.cpp
 SOURCES += engine/action/sc_action.cpp
 SOURCES += engine/action/sc_action_state.cpp
@@ -187,6 +193,7 @@ SOURCES += engine/action/sc_stats.cpp
 SOURCES += engine/action/sequence.cpp
 SOURCES += engine/action/snapshot_stats.cpp
 SOURCES += engine/action/variable.cpp
+SOURCES += engine/buff/buff_registry.cpp
 SOURCES += engine/buff/sc_buff.cpp
 SOURCES += engine/class_modules/apl/mage.cpp
 SOURCES += engine/class_modules/paladin/sc_paladin.cpp
@@ -217,6 +224,7 @@ SOURCES += engine/dbc/azerite.cpp
 SOURCES += engine/dbc/client_data.cpp
 SOURCES += engine/dbc/client_hotfix_entry.cpp
 SOURCES += engine/dbc/covenant_data.cpp
+SOURCES += engine/dbc/data_bundle.cpp
 SOURCES += engine/dbc/gem_data.cpp
 SOURCES += engine/dbc/item_armor.cpp
 SOURCES += engine/dbc/item_bonus.cpp
@@ -308,6 +316,7 @@ SOURCES += engine/sim/sc_profileset.cpp
 SOURCES += engine/sim/sc_progress_bar.cpp
 SOURCES += engine/sim/sc_raid_event.cpp
 SOURCES += engine/sim/sc_reforge_plot.cpp
+SOURCES += engine/sim/sc_shard.cpp
 SOURCES += engine/sim/sc_sim.cpp
 SOURCES += engine/sim/scale_factor_control.cpp
 SOURCES += engine/sim/shuffled_rng.cpp
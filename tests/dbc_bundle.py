@@ -0,0 +1,33 @@
+# Check for the binary client data bundle. Writes a bundle from the compiled-in
+# client data (dbc_bundle_output=), sims the test profile with and without the
+# bundle loaded (dbc_bundle=), and requires identical results, since the
+# bundle holds the same data and the sims use the same seed. Spell texts are
+# bundled through the string pool of the bundle, and are checked by comparing
+# the output of a spell query with and without the bundle.
+
+import os
+import tempfile
+
+from helper import CheckFailed, run_simc, player_dps, read_report
+
+SPELL_QUERY = 'spell_query=spell.class=priest'
+
+
+def check_dbc_bundle(test):
+    # A single thread with a fixed seed makes the results of each run identical
+    options = test.args() + ['threads=1', 'seed=1']
+    with tempfile.TemporaryDirectory() as tmp:
+        bundle = os.path.join(tmp, 'client_data.bin')
+        run_simc(['dbc_bundle_output={}'.format(bundle)])
+
+        # The first line is the version info, which names the loaded bundle
+        if (run_simc([SPELL_QUERY]).splitlines()[1:] !=
+                run_simc([SPELL_QUERY, 'dbc_bundle={}'.format(bundle)]).splitlines()[1:]):
+            raise CheckFailed('Spell query output differs with the bundle loaded')
+
+        compiled = os.path.join(tmp, 'compiled.json')
+        bundled = os.path.join(tmp, 'bundled.json')
+        run_simc(options + ['json2={}'.format(compiled)])
+        run_simc(options + ['dbc_bundle={}'.format(bundle), 'json2={}'.format(bundled)])
+        if player_dps(read_report(compiled)) != player_dps(read_report(bundled)):
+            raise CheckFailed('Results differ with the bundle loaded')
@@ -1,4 +1,4 @@
-import sys, os, shutil, subprocess, re, signal, shlex
+import sys, os, shutil, subprocess, re, signal, shlex, time, json
 from pathlib import Path
 
 def __error_status(code):
@@ -53,6 +53,8 @@ class Test(object):
         self._iterations = kwargs.get('iterations', group and group.iterations or SIMC_ITERATIONS)
         self._threads = kwargs.get('threads', group and group.threads or SIMC_THREADS)
         self._args = kwargs.get('args', [])
+        # Callable run with the test in place of a single simc run, see run_check()
+        self._check = kwargs.get('check')
 
     def args(self):
         args = [
@@ -71,8 +73,40 @@ class Test(object):
                 args.append(shlex.quote(str(arg)))
         return args
 
+# Raised by checks when simc ran fine, but its results are wrong
+class CheckFailed(Exception):
+    pass
+
+# Run simc with the given options, returning its output. Raises
+# subprocess.CalledProcessError like a failed test run.
+def run_simc(options):
+    res = subprocess.run([ SIMC_CLI_PATH ] + options, check=True, stdout=subprocess.PIPE, stderr=subprocess.PIPE, encoding='UTF-8')
+    return res.stdout
+
+# Collected DPS data of each player in a JSON report
+def player_dps(report):
+    return { player['name']: player['collected_data']['dps'] for player in report['sim']['players'] }
+
+def read_report(path):
+    with open(path, encoding='UTF-8') as f:
+        return json.load(f)
+
+# Tests with a check run it with the test, in place of a single simc run with
+# the test options. The check runs simc as often as it needs through
+# run_simc(), and raises CheckFailed if the results are wrong.
+def run_check(test):
+    start = time.perf_counter()
+    try:
+        test._check(test)
+        return ( True, time.perf_counter() - start, None )
+    except ( subprocess.CalledProcessError, CheckFailed ) as err:
+        return ( False, 0, err )
+
 SIMC_WALL_SECONDS_RE = re.compile('WallSeconds\\s*=\\s*([0-9\\.]+)')
 def run_test(test):
+    if test._check:
+        return run_check(test)
+
     args = [ SIMC_CLI_PATH ]
     args.extend(test.args())
 
@@ -98,10 +132,14 @@ def run(tests):
             success += 1
         else:
             print('[FAIL]')
-            print('-- {:<62} --------------'.format(__error_status(err.returncode)))
-            print(err.cmd)
-            if err.stderr:
-                print(err.stderr.rstrip('\r\n'))
+            if isinstance(err, CheckFailed):
+                print('-- {:<62} --------------'.format('Check failed'))
+                print(err)
+            else:
+                print('-- {:<62} --------------'.format(__error_status(err.returncode)))
+                print(err.cmd)
+                if err.stderr:
+                    print(err.stderr.rstrip('\r\n'))
             print('-' * 80)
             failure += 1
 
@@ -0,0 +1,29 @@
+# Check for the streaming JSON report writer. Writes the report of the same sim
+# both as a whole document built in memory (streaming=0) and through the
+# streaming writer (streaming=1), with full action states, and requires both
+# reports to be identical.
+
+import os
+import re
+import tempfile
+
+from helper import CheckFailed, run_simc
+
+TIMESTAMP_RE = re.compile(rb'"timestamp":\s*[0-9]+')
+
+
+def read_report(path):
+    with open(path, 'rb') as f:
+        return TIMESTAMP_RE.sub(b'"timestamp":0', f.read())
+
+
+def check_json_report(test):
+    with tempfile.TemporaryDirectory() as tmp:
+        document = os.path.join(tmp, 'document.json')
+        streamed = os.path.join(tmp, 'streaming.json')
+        run_simc(test.args() + [
+            'json={},streaming=0,full_states=1'.format(document),
+            'json={},streaming=1,full_states=1'.format(streamed),
+        ])
+        if read_report(document) != read_report(streamed):
+            raise CheckFailed('Streamed report differs from the report document')
@@ -0,0 +1,21 @@
+# Check for memoized if expressions (memoize_conditions=1). Runs the test
+# profile with validate_memoized_conditions=1, which evaluates every reused
+# result in full and reports a mismatch as a sim error. A mismatch means some
+# code changed state an expression reads without bumping its version counter.
+
+import os
+import tempfile
+
+from helper import CheckFailed, run_simc, read_report
+
+
+def check_memoized_conditions(test):
+    with tempfile.TemporaryDirectory() as tmp:
+        report = os.path.join(tmp, 'report.json')
+        run_simc(test.args() + ['memoize_conditions=1', 'validate_memoized_conditions=1',
+                                'json2={}'.format(report)])
+        notifications = read_report(report).get('notifications', [])
+
+    mismatches = [n for n in notifications if 'memoized if expression' in n]
+    if mismatches:
+        raise CheckFailed('\n'.join(mismatches))
@@ -16,6 +16,11 @@ except ImportError:
 
 from helper import Test, TestGroup, run, find_profiles
 from talent_options import talent_combinations
+from server_mode import check_server
+from json_report import check_json_report
+from shard_merge import check_shard_merge
+from dbc_bundle import check_dbc_bundle
+from memoized_conditions import check_memoized_conditions
 
 FIGHT_STYLES = ('Patchwerk', 'DungeonSlice', 'HeavyMovement')
 
@@ -103,12 +108,47 @@ def test_soulbinds(klass: str, path: str):
                             ('covenant', covenant.simc_name), ('level', 60), ('soulbind', '{},{}'.format(soulbind.simc_name, soulbind_talent.spell_id))])
 
 
+def test_server(klass: str, path: str):
+    grp = TestGroup('{}/server'.format(profile), profile=path)
+    tests.append(grp)
+    Test('Server jobs match separate processes', group=grp, check=check_server)
+
+
+def test_json_report(klass: str, path: str):
+    grp = TestGroup('{}/json_report'.format(profile), profile=path)
+    tests.append(grp)
+    Test('Streamed report matches report document', group=grp, check=check_json_report)
+
+
+def test_shard(klass: str, path: str):
+    grp = TestGroup('{}/shard'.format(profile), profile=path)
+    tests.append(grp)
+    Test('Merged shards match a single sim', group=grp, check=check_shard_merge)
+
+
+def test_dbc_bundle(klass: str, path: str):
+    grp = TestGroup('{}/dbc_bundle'.format(profile), profile=path)
+    tests.append(grp)
+    Test('Bundled client data matches compiled-in data', group=grp, check=check_dbc_bundle)
+
+
+def test_memoize(klass: str, path: str):
+    grp = TestGroup('{}/memoize'.format(profile), profile=path)
+    tests.append(grp)
+    Test('Memoized conditions match full evaluation', group=grp, check=check_memoized_conditions)
+
+
 available_tests = {
     "talent": test_talents,
     "covenant": test_covenants,
     "trinket": test_trinkets,
     "legendary": test_legendaries,
-    "soulbind": test_soulbinds
+    "soulbind": test_soulbinds,
+    "server": test_server,
+    "json_report": test_json_report,
+    "shard": test_shard,
+    "dbc_bundle": test_dbc_bundle,
+    "memoize": test_memoize,
 }
 
 parser = argparse.ArgumentParser(description='Run simc tests.')
@@ -0,0 +1,43 @@
+# Check for the simc job server (server=1). Runs the test profile as several
+# jobs through a single server process, and requires each job to report the
+# same results as a separate simc process with the same seed. Later jobs reuse
+# the warm spell data and parked threads of the first one.
+
+import json
+import os
+import subprocess
+import tempfile
+
+from helper import SIMC_CLI_PATH, CheckFailed, run_simc, player_dps, read_report
+
+JOBS = 3
+
+
+def dps_means(report):
+    return {name: dps['mean'] for name, dps in player_dps(report).items()}
+
+
+def check_server(test):
+    # A single thread with a fixed seed makes the results of each run identical
+    options = test.args() + ['threads=1', 'seed=1']
+    with tempfile.TemporaryDirectory() as tmp:
+        path = os.path.join(tmp, 'process.json')
+        run_simc(options + ['json2={}'.format(path)])
+        expected = dps_means(read_report(path))
+
+    proc = subprocess.run([SIMC_CLI_PATH, 'server=1'],
+                          input=''.join(json.dumps({'id': idx, 'args': options}) + '\n' for idx in range(JOBS)),
+                          stdout=subprocess.PIPE, stderr=subprocess.PIPE, encoding='UTF-8', check=True)
+
+    responses = [json.loads(line) for line in proc.stdout.splitlines()]
+    if len(responses) != JOBS:
+        raise CheckFailed('{} responses for {} jobs'.format(len(responses), JOBS))
+
+    # Jobs are answered in order, one line each
+    for idx, response in enumerate(responses):
+        if response['id'] != idx:
+            raise CheckFailed('Out of order response {} for job {}'.format(response['id'], idx))
+        if response['status'] != 'ok':
+            raise CheckFailed('Job {} failed: {}'.format(idx, response.get('error')))
+        if dps_means(response['report']) != expected:
+            raise CheckFailed('Job {} results differ from a separate simc process'.format(idx))
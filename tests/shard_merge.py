@@ -0,0 +1,44 @@
+# Check for distributed sims through result shards. Runs the test profile as
+# a number of shard processes (shard_output=), merges their shard files in
+# another process (shard_merge=), and compares the merged DPS of each actor
+# against a single sim of all the iterations.
+
+import os
+import tempfile
+
+from helper import CheckFailed, run_simc, player_dps, read_report
+
+SHARDS = 4
+# Iterations per shard, enough for meaningful standard errors
+ITERATIONS = 50
+
+
+def check_shard_merge(test):
+    options = test.args()
+    with tempfile.TemporaryDirectory() as tmp:
+        shards = []
+        for idx in range(SHARDS):
+            shard = os.path.join(tmp, 'shard{}.bin'.format(idx))
+            run_simc(options + ['iterations={}'.format(ITERATIONS), 'shard_index={}'.format(idx),
+                                'shard_output={}'.format(shard)])
+            shards.append(shard)
+
+        merged = os.path.join(tmp, 'merged.json')
+        run_simc(options + ['shard_merge={}'.format(shard) for shard in shards] + ['json2={}'.format(merged)])
+
+        single = os.path.join(tmp, 'single.json')
+        run_simc(options + ['iterations={}'.format(ITERATIONS * SHARDS), 'json2={}'.format(single)])
+
+        merged_dps = player_dps(read_report(merged))
+        single_dps = player_dps(read_report(single))
+
+    for name, dps in sorted(single_dps.items()):
+        if name not in merged_dps:
+            raise CheckFailed('{} is missing from the merged report'.format(name))
+
+        merged_mean = merged_dps[name]['mean']
+        # Both are estimates of the same mean, allow for 4 standard errors of their difference
+        limit = 4 * (dps.get('mean_std_dev', 0.0) ** 2 + merged_dps[name].get('mean_std_dev', 0.0) ** 2) ** 0.5
+        if abs(merged_mean - dps['mean']) > limit:
+            raise CheckFailed('{} merged DPS {:.2f} differs from single sim DPS {:.2f} by more than {:.2f}'.format(
+                name, merged_mean, dps['mean'], limit))